@@ -0,0 +1,68 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>  // For the steady clock
+#include <cstdint> // For std::uint64_t
+#include <cstdio>  // For std::printf
+#include <vector>  // For collected samples
+
+#include "core/frame_times.h"
+
+// Tiny helpers shared by the benchmark executables (no external benchmark library needed)
+namespace bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    class Timer
+    {
+    public:
+        Timer() : m_start(Clock::now()) {}
+        void reset() { m_start = Clock::now(); }
+        double seconds() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+        double millis() const { return seconds() * 1e3; }
+        double micros() const { return seconds() * 1e6; }
+
+    private:
+        Clock::time_point m_start;
+    };
+
+    // Keeps the compiler from optimising away a value the benchmark never uses
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Deterministic xorshift generator so runs are comparable
+    struct Rng
+    {
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+
+        std::uint64_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+        int range(int lo, int hi) { return lo + int(next() % std::uint64_t(hi - lo)); }
+    };
+
+    // Same definition as the game's own frame time report (see core/frame_times.h); sorts the samples in place
+    inline double percentile(std::vector<double> &samples, double p)
+    {
+        return ::percentile(samples, p);
+    }
+
+    inline void header(const char *title)
+    {
+        std::printf("\n== %s ==\n", title);
+    }
+
+    inline void rate(const char *label, double operations, double seconds, const char *unit)
+    {
+        std::printf("%-40s %12.2f M%s/s  (%.3f ns/op)\n", label, operations / seconds / 1e6, unit, seconds * 1e9 / operations);
+    }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef BENCH_WORLD_H
+#define BENCH_WORLD_H
+
+#include <cstdint> // For the seed
+
+#include "world/terrain_generator.h"
+#include "world/world.h"
+
+// Generated terrain shared by the benchmarks that need a real world (lighting, raycasts, physics, entities)
+namespace bench
+{
+    constexpr std::uint64_t WORLD_SEED = 1337;
+    constexpr float TICK_SECONDS = 1.0f / 30.0f; // The game's simulation tick
+    constexpr int SETTLE_TICKS = 60;             // Ticks that let spawned bodies land before anything is timed
+
+    // area x area generated chunks, centred on the origin
+    inline void generateWorld(World &world, int area)
+    {
+        TerrainGenerator generator(WORLD_SEED);
+        for (int z = -area / 2; z < area / 2; ++z)
+            for (int x = -area / 2; x < area / 2; ++x)
+                world.insertChunk(generator.generate({x, z}));
+    }
+
+    // Block coordinates in [-extent, extent) of such a world stay margin blocks away from the unloaded outside
+    inline int worldExtent(int area, int margin)
+    {
+        return area / 2 * CHUNK_SIZE - margin;
+    }
+
+    // Topmost opaque block of a column, -1 if there is none
+    inline int surfaceY(const World &world, int x, int z)
+    {
+        for (int y = CHUNK_HEIGHT - 1; y >= 0; --y)
+            if (isOpaque(world.getBlock(x, y, z)))
+                return y;
+        return -1;
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+// CPU cost of submitting the chunk geometry: one draw call per section against one multi-draw call per frame
+// (glMultiDrawElementsBaseVertex, and glMultiDrawElementsIndirect when the driver has it). Generates and meshes
+// a (2 * radius)^2 chunk world, then renders every section from above so culling keeps all of them.
+// Needs an OpenGL context, so it opens a hidden window (4.3 if available, else 3.3).
+// Run from the build directory (it loads the game shaders from ../src).
+//
+// Usage: chunk_draw_bench [radius]   (default 16, 1024 chunks)
+
+#include <glad/glad.h>  // For OpenGL functions
+#include <GLFW/glfw3.h> // For the hidden window and context
+
+#include <cstdio>  // For std::printf
+#include <cstdlib> // For std::atoi
+#include <memory>  // For std::unique_ptr
+#include <vector>  // For samples
+
+#include "bench_util.h"
+#include "core/camera.h"
+#include "core/job_system.h"
+#include "render/chunk_renderer.h"
+#include "shader.h"
+#include "world/terrain_generator.h"
+#include "world/world.h"
+
+namespace
+{
+    constexpr int FRAMES = 200;
+
+    GLFWwindow *createHiddenWindow(int major, int minor)
+    {
+        glfwDefaultWindowHints();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        return glfwCreateWindow(256, 256, "chunk_draw_bench", NULL, NULL);
+    }
+
+    void measure(ChunkRenderer &renderer, DrawPath path, const Frustum &frustum)
+    {
+        renderer.setDrawPath(path);
+        FrameStats frame;
+        std::vector<double> submit, total;
+        for (int i = 0; i < FRAMES + 10; ++i)
+        {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            frame.reset();
+            bench::Timer timer;
+            renderer.draw(frame, frustum);
+            double submitMillis = timer.millis();
+            glFinish(); // Count the GPU and driver work too, not just the queueing
+            if (i >= 10) // Warm-up frames excluded
+            {
+                submit.push_back(submitMillis);
+                total.push_back(timer.millis());
+            }
+        }
+        std::printf("%-22s %7zu draws %9zu sections %9.3f ms CPU submit %9.3f ms with glFinish\n", drawPathName(path), frame.drawCalls,
+                    renderer.cullStats().sectionsVisible, bench::percentile(submit, 50), bench::percentile(total, 50));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int radius = argc > 1 ? std::atoi(argv[1]) : 16;
+    if (!glfwInit())
+    {
+        std::printf("Failed to initialize GLFW\n");
+        return 1;
+    }
+    GLFWwindow *window = createHiddenWindow(4, 3);
+    if (!window)
+        window = createHiddenWindow(3, 3);
+    if (!window)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::printf("Failed to initialize GLAD\n");
+        glfwTerminate();
+        return 1;
+    }
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    {
+        JobSystem jobs;
+        World world;
+        TerrainGenerator generator(1337);
+        for (int z = -radius; z < radius; ++z)
+            for (int x = -radius; x < radius; ++x)
+                world.insertChunk(generator.generate(ChunkPos{x, z}));
+
+        // Mesh and upload everything before measuring
+        ChunkRenderer renderer(jobs, (GLADloadproc)glfwGetProcAddress);
+        UploadBudget unlimited;
+        unlimited.maxBytes = ~std::size_t(0);
+        unlimited.maxMillis = 1e9;
+        bench::Timer meshTimer;
+        do
+            renderer.update(world, unlimited);
+        while (renderer.stats().meshingJobs > 0 || renderer.stats().pendingUploads > 0);
+        std::printf("%d chunks, %zu section meshes, %zu KiB of geometry, meshed and uploaded in %.0f ms\n", 4 * radius * radius,
+                    renderer.meshCount(), (renderer.stats().vertexBytes + renderer.stats().indexBytes) / 1024, meshTimer.millis());
+
+        Shader shader("../src/myVertexShader.vs", "../src/myFragmentShaderColors.fs");
+        shader.use();
+        shader.setInt("blockTextures", 0);
+        shader.setInt("sectionOrigins", 1);
+
+        // High above the centre looking straight down, with a field of view wide enough for the whole world
+        Camera camera;
+        camera.position = Vec3(0.0f, float(radius * CHUNK_SIZE) * 1.5f + 256.0f, 0.0f);
+        camera.pitch = -1.5707f;
+        camera.fovY = 2.0f;
+        camera.zFar = 10000.0f;
+        Mat4 viewProjection = camera.viewProjection(1.0f);
+        shader.setMat4("viewProjection", viewProjection);
+        Frustum frustum(viewProjection);
+
+        bench::header("Chunk draw submission (median of 200 frames)");
+        std::printf("GL %s\n", reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+        measure(renderer, DrawPath::PER_SECTION, frustum);
+        measure(renderer, DrawPath::MULTI_DRAW, frustum);
+        if (renderer.multiDrawIndirectSupported())
+            measure(renderer, DrawPath::MULTI_DRAW_INDIRECT, frustum);
+        else
+            std::printf("%-22s not supported by this driver\n", drawPathName(DrawPath::MULTI_DRAW_INDIRECT));
+
+        glDeleteProgram(shader.ID);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
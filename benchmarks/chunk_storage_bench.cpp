@@ -0,0 +1,116 @@
+// Measures block get/set throughput and memory per chunk of the chunked world storage.
+// CPU only: no window or OpenGL context is created.
+
+#include <cstdio> // For std::printf
+
+#include "bench_util.h"
+#include "world/world.h"
+
+namespace
+{
+    // Fills a chunk like typical terrain: stone up to height-4, dirt, then a grass layer
+    void fillTerrain(Chunk &chunk, int height)
+    {
+        for (int y = 0; y <= height; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    chunk.setBlock(x, y, z, y == height ? Blocks::GRASS : (y > height - 4 ? Blocks::DIRT : Blocks::STONE));
+    }
+
+    void memoryReport()
+    {
+        bench::header("Memory per chunk");
+
+        Chunk empty({0, 0});
+        Chunk flat({0, 0});
+        fillTerrain(flat, 64);
+        Chunk full({0, 0});
+        fillTerrain(full, CHUNK_HEIGHT - 1);
+
+        std::printf("%-40s %10zu bytes\n", "empty chunk", empty.memoryUsage());
+        std::printf("%-40s %10zu bytes (%d sections)\n", "terrain chunk (height 64)", flat.memoryUsage(), flat.allocatedSections());
+        std::printf("%-40s %10zu bytes (%d sections)\n", "completely filled chunk", full.memoryUsage(), full.allocatedSections());
+
+        // A 32-chunk view radius keeps a (2 * 32 + 1)^2 square of chunk columns loaded
+        const int radius = 32;
+        const int columns = (2 * radius + 1) * (2 * radius + 1);
+        double megabytes = double(columns) * double(flat.memoryUsage()) / (1024.0 * 1024.0);
+        std::printf("%-40s %10d chunks, %.1f MiB of terrain chunks\n", "32-chunk view radius", columns, megabytes);
+    }
+
+    void chunkThroughput()
+    {
+        bench::header("Chunk-local access");
+
+        Chunk chunk({0, 0});
+        fillTerrain(chunk, 64);
+        const int rounds = 200;
+        const double volume = double(CHUNK_SIZE) * 80 * CHUNK_SIZE;
+
+        // Sequential reads in storage order (x fastest)
+        bench::Timer timer;
+        unsigned sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (int y = 0; y < 80; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        sum += chunk.getBlock(x, y, z);
+        bench::doNotOptimize(sum);
+        bench::rate("sequential getBlock", rounds * volume, timer.seconds(), "blocks");
+
+        // Sequential writes alternating between two non-air IDs so every write changes the block
+        timer.reset();
+        for (int r = 0; r < rounds; ++r)
+        {
+            BlockID id = (r & 1) ? Blocks::STONE : Blocks::DIRT;
+            for (int y = 0; y < 80; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        chunk.setBlock(x, y, z, id);
+        }
+        bench::rate("sequential setBlock", rounds * volume, timer.seconds(), "blocks");
+    }
+
+    void worldThroughput()
+    {
+        bench::header("World access (random coordinates, 16x16 chunks)");
+
+        World world;
+        const int radius = 8;
+        for (int cz = -radius; cz < radius; ++cz)
+            for (int cx = -radius; cx < radius; ++cx)
+                fillTerrain(world.getOrCreateChunk({cx, cz}), 64);
+
+        const int count = 4'000'000;
+        std::vector<int> coords(count * 3);
+        bench::Rng rng;
+        for (int i = 0; i < count; ++i)
+        {
+            coords[i * 3 + 0] = rng.range(-radius * CHUNK_SIZE, radius * CHUNK_SIZE);
+            coords[i * 3 + 1] = rng.range(0, 80);
+            coords[i * 3 + 2] = rng.range(-radius * CHUNK_SIZE, radius * CHUNK_SIZE);
+        }
+
+        bench::Timer timer;
+        unsigned sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += world.getBlock(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]);
+        bench::doNotOptimize(sum);
+        bench::rate("random World::getBlock", count, timer.seconds(), "blocks");
+
+        timer.reset();
+        for (int i = 0; i < count; ++i)
+            world.setBlock(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2], (i & 1) ? Blocks::STONE : Blocks::SAND);
+        bench::rate("random World::setBlock", count, timer.seconds(), "blocks");
+
+        std::printf("%-40s %10zu chunks, %.1f MiB\n", "world size", world.chunkCount(), world.memoryUsage() / (1024.0 * 1024.0));
+    }
+}
+
+int main()
+{
+    memoryReport();
+    chunkThroughput();
+    worldThroughput();
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Entity storage: 100k mobs, dropped items and projectiles in the archetype tables. Measures plain iteration
+// over one component against heap allocated objects updated through a virtual call, the full simulation tick
+// (collision, AI, projectile rays) serially and on the job system, and the cost of creating and destroying.
+
+#include <cstdio> // For std::printf
+#include <memory> // For the object baseline
+#include <vector> // For samples and the baseline
+
+#include "bench_util.h"
+#include "bench_world.h"
+#include "world/entities.h"
+
+namespace
+{
+    constexpr int AREA = 16;           // AREA x AREA chunks
+    constexpr int ENTITIES = 100000;
+    constexpr int MOBS = 60000;        // Then items, then projectiles
+    constexpr int ITEMS = 30000;
+    constexpr int ITERATIONS = 50;
+    constexpr int TICKS = 100;
+
+    Vec3 randomPosition(bench::Rng &rng)
+    {
+        int extent = bench::worldExtent(AREA, 16);
+        return {float(rng.range(-extent, extent)) + 0.5f, float(rng.range(90, CHUNK_HEIGHT - 8)), float(rng.range(-extent, extent)) + 0.5f};
+    }
+
+    void populate(EntityRegistry &registry)
+    {
+        bench::Rng rng;
+        for (int i = 0; i < ENTITIES; ++i)
+        {
+            Vec3 position = randomPosition(rng);
+            if (i < MOBS)
+                spawnMob(registry, position, std::uint32_t(i + 1));
+            else if (i < MOBS + ITEMS)
+                dropItem(registry, position, Blocks::DIRT);
+            else
+                shootProjectile(registry, position, Vec3{float(rng.range(-20, 20)), float(rng.range(0, 20)), float(rng.range(-20, 20))});
+        }
+    }
+
+    // The usual object oriented layout: every entity its own heap allocation, updated through a virtual call
+    struct GameObject
+    {
+        virtual ~GameObject() = default;
+        virtual void update(float seconds) = 0;
+
+        Vec3 position;
+        Vec3 velocity;
+        float health = 20.0f;
+        char name[32] = {};
+        Vec3 lastPosition;
+        bool visible = true;
+    };
+
+    struct FlyingObject : GameObject
+    {
+        void update(float seconds) override { position += velocity * seconds; }
+    };
+
+    double iterationNanos(std::vector<double> &samples)
+    {
+        return bench::percentile(samples, 50) * 1e6 / ENTITIES;
+    }
+}
+
+int main()
+{
+    bench::header("Iteration: position += velocity * dt over 100k entities (median)");
+    {
+        std::vector<std::unique_ptr<GameObject>> objects;
+        objects.reserve(ENTITIES);
+        EntityRegistry registry;
+        bench::Rng rng;
+        for (int i = 0; i < ENTITIES; ++i)
+        {
+            Vec3 position = randomPosition(rng);
+            Vec3 velocity{1.0f, 0.0f, 0.5f};
+            auto object = std::make_unique<FlyingObject>();
+            object->position = position;
+            object->velocity = velocity;
+            objects.push_back(std::move(object));
+            registry.create(Projectile{position, velocity, false}, Lifetime{60.0f});
+        }
+
+        std::vector<double> objectSamples, tableSamples;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            bench::Timer objectTimer;
+            for (auto &object : objects)
+                object->update(bench::TICK_SECONDS);
+            objectSamples.push_back(objectTimer.millis());
+
+            bench::Timer tableTimer;
+            registry.each<Projectile>([](Entity, Projectile &projectile) { projectile.position += projectile.velocity * bench::TICK_SECONDS; });
+            tableSamples.push_back(tableTimer.millis());
+        }
+        std::printf("%-40s %8.2f ns/entity\n", "heap objects, virtual update", iterationNanos(objectSamples));
+        std::printf("%-40s %8.2f ns/entity (%.1fx)\n", "archetype table", iterationNanos(tableSamples),
+                    iterationNanos(objectSamples) / iterationNanos(tableSamples));
+    }
+
+    World world;
+    bench::generateWorld(world, AREA);
+    JobSystem jobs;
+
+    bench::header("Simulation tick: 60k mobs, 30k items, 10k projectiles (median)");
+    for (JobSystem *pool : {static_cast<JobSystem *>(nullptr), &jobs})
+    {
+        EntityRegistry registry;
+        EntitySystems systems;
+        populate(registry);
+        for (int tick = 0; tick < bench::SETTLE_TICKS; ++tick)
+            systems.update(registry, world, bench::TICK_SECONDS, pool);
+
+        std::vector<double> samples;
+        for (int tick = 0; tick < TICKS; ++tick)
+        {
+            bench::Timer timer;
+            systems.update(registry, world, bench::TICK_SECONDS, pool);
+            samples.push_back(timer.millis());
+        }
+        double median = bench::percentile(samples, 50);
+        std::printf("%-40s %8.3f ms %8.1f ns/entity %6.1f%% of the tick, %zu archetypes, %.1f MiB\n",
+                    pool ? "job system" : "serial", median, median * 1e6 / double(registry.count()),
+                    100.0 * median / (bench::TICK_SECONDS * 1000.0), registry.archetypeCount(), double(registry.memoryUsage()) / (1024.0 * 1024.0));
+    }
+    std::printf("(%u workers)\n", jobs.workerCount());
+
+    bench::header("Structural changes");
+    {
+        EntityRegistry registry;
+        std::vector<Entity> entities;
+        entities.reserve(ENTITIES);
+        bench::Timer createTimer;
+        for (int i = 0; i < ENTITIES; ++i)
+            entities.push_back(dropItem(registry, Vec3{0.0f, 100.0f, 0.0f}, Blocks::DIRT));
+        double createNanos = createTimer.seconds() * 1e9 / ENTITIES;
+
+        bench::Timer addTimer;
+        for (Entity entity : entities)
+            registry.remove<Lifetime>(entity);
+        double moveNanos = addTimer.seconds() * 1e9 / ENTITIES;
+
+        bench::Timer destroyTimer;
+        for (Entity entity : entities)
+            registry.destroy(entity);
+        double destroyNanos = destroyTimer.seconds() * 1e9 / ENTITIES;
+        std::printf("%-40s %8.1f ns\n", "create (item: body, item, lifetime)", createNanos);
+        std::printf("%-40s %8.1f ns\n", "remove a component (moves tables)", moveNanos);
+        std::printf("%-40s %8.1f ns\n", "destroy", destroyNanos);
+    }
+    return 0;
+}
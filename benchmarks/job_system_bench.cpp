@@ -0,0 +1,165 @@
+// Micro-benchmarks for the work-stealing job system against std::async on fine-grained voxel tasks.
+
+#include <algorithm> // For std::max
+#include <atomic>    // For the shared result counters
+#include <cstdio>    // For std::printf
+#include <future>    // For std::async, the baseline
+#include <thread>    // For std::thread::hardware_concurrency
+
+#include "bench_util.h"
+#include "core/job_system.h"
+#include "world/world.h"
+
+namespace
+{
+    constexpr int WORLD_RADIUS = 8; // 16x16 chunks, 256 chunk-sized tasks
+
+    void buildWorld(World &world)
+    {
+        bench::Rng rng;
+        for (int cz = -WORLD_RADIUS; cz < WORLD_RADIUS; ++cz)
+            for (int cx = -WORLD_RADIUS; cx < WORLD_RADIUS; ++cx)
+            {
+                Chunk &chunk = world.getOrCreateChunk({cx, cz});
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                    {
+                        int height = 50 + rng.range(0, 20);
+                        for (int y = 0; y <= height; ++y)
+                            chunk.setBlock(x, y, z, y == height ? Blocks::GRASS : Blocks::STONE);
+                    }
+            }
+    }
+
+    // The fine-grained voxel task: count the solid blocks of one section
+    int countSolid(const Chunk &chunk, int sectionY)
+    {
+        const ChunkSection *section = chunk.section(sectionY);
+        if (!section)
+            return 0;
+        int count = 0;
+        for (int y = 0; y < SECTION_SIZE; ++y)
+            for (int z = 0; z < SECTION_SIZE; ++z)
+                for (int x = 0; x < SECTION_SIZE; ++x)
+                    count += isOpaque(section->getBlock(x, y, z));
+        return count;
+    }
+
+    void report(const char *label, std::size_t tasks, double seconds, double serialSeconds)
+    {
+        std::printf("%-36s %9.2f ms  %8.2f us/task  speedup %.2fx\n", label, seconds * 1e3, seconds * 1e6 / tasks, serialSeconds / seconds);
+    }
+}
+
+int main()
+{
+    World world;
+    buildWorld(world);
+
+    // One task per section of every chunk
+    std::vector<const Chunk *> chunks;
+    for (const auto &[pos, chunk] : world.chunks())
+        chunks.push_back(chunk.get());
+    const std::size_t taskCount = chunks.size() * SECTIONS_PER_CHUNK;
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    JobSystem jobs(hardwareThreads);
+
+    bench::header("Counting solid blocks, one task per section");
+    std::printf("%zu tasks, %u workers\n", taskCount, jobs.workerCount());
+
+    long long expected = 0;
+    bench::Timer timer;
+    for (std::size_t i = 0; i < taskCount; ++i)
+        expected += countSolid(*chunks[i / SECTIONS_PER_CHUNK], int(i % SECTIONS_PER_CHUNK));
+    double serial = timer.seconds();
+    report("serial", taskCount, serial, serial);
+
+    {
+        timer.reset();
+        std::vector<std::future<int>> futures;
+        futures.reserve(taskCount);
+        for (std::size_t i = 0; i < taskCount; ++i)
+            futures.push_back(std::async(std::launch::async, [&, i] { return countSolid(*chunks[i / SECTIONS_PER_CHUNK], int(i % SECTIONS_PER_CHUNK)); }));
+        long long total = 0;
+        for (auto &f : futures)
+            total += f.get();
+        report("std::async per task", taskCount, timer.seconds(), serial);
+        if (total != expected)
+            std::printf("  MISMATCH: %lld != %lld\n", total, expected);
+    }
+
+    {
+        timer.reset();
+        std::atomic<long long> total{0};
+        std::vector<JobHandle> handles;
+        handles.reserve(taskCount);
+        for (std::size_t i = 0; i < taskCount; ++i)
+            handles.push_back(jobs.schedule([&, i] { total += countSolid(*chunks[i / SECTIONS_PER_CHUNK], int(i % SECTIONS_PER_CHUNK)); }));
+        jobs.waitAll(handles);
+        report("JobSystem::schedule per task", taskCount, timer.seconds(), serial);
+        if (total != expected)
+            std::printf("  MISMATCH: %lld != %lld\n", total.load(), expected);
+    }
+
+    for (std::size_t grain : {1, 16, 256})
+    {
+        timer.reset();
+        std::atomic<long long> total{0};
+        jobs.parallelFor(0, taskCount, grain, [&](std::size_t first, std::size_t last)
+        {
+            long long local = 0;
+            for (std::size_t i = first; i < last; ++i)
+                local += countSolid(*chunks[i / SECTIONS_PER_CHUNK], int(i % SECTIONS_PER_CHUNK));
+            total += local;
+        });
+        char label[64];
+        std::snprintf(label, sizeof(label), "JobSystem::parallelFor grain %zu", grain);
+        report(label, taskCount, timer.seconds(), serial);
+        if (total != expected)
+            std::printf("  MISMATCH: %lld != %lld\n", total.load(), expected);
+    }
+
+    {
+        // Two-stage graph: count per chunk, then a continuation per chunk that depends on it
+        timer.reset();
+        std::vector<int> perChunk(chunks.size());
+        std::atomic<long long> total{0};
+        std::vector<JobHandle> tails;
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+        {
+            JobHandle count = jobs.schedule([&, c]
+            {
+                int sum = 0;
+                for (int s = 0; s < SECTIONS_PER_CHUNK; ++s)
+                    sum += countSolid(*chunks[c], s);
+                perChunk[c] = sum;
+            });
+            tails.push_back(jobs.schedule([&, c] { total += perChunk[c]; }, {count}));
+        }
+        jobs.waitAll(tails);
+        report("JobSystem chunk job + continuation", taskCount, timer.seconds(), serial);
+        if (total != expected)
+            std::printf("  MISMATCH: %lld != %lld\n", total.load(), expected);
+    }
+
+    bench::header("Scheduling overhead (empty tasks)");
+    {
+        const int count = 5000;
+        timer.reset();
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < count; ++i)
+            futures.push_back(std::async(std::launch::async, [] {}));
+        for (auto &f : futures)
+            f.get();
+        std::printf("%-36s %8.2f us/task\n", "std::async", timer.micros() / count);
+
+        timer.reset();
+        std::vector<JobHandle> handles;
+        for (int i = 0; i < count; ++i)
+            handles.push_back(jobs.schedule([] {}));
+        jobs.waitAll(handles);
+        std::printf("%-36s %8.2f us/task\n", "JobSystem::schedule", timer.micros() / count);
+    }
+    return 0;
+}
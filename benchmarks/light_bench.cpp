@@ -0,0 +1,99 @@
+// Voxel lighting: time to light a chunk from scratch (on load) and the latency of relighting after a single
+// block edit, which only visits the region the edit reaches. Blocks placed on the surface shadow what is below,
+// broken surface blocks let the sky in, lamps spread block light up to 14 blocks away.
+
+#include <cstdio> // For std::printf
+#include <vector> // For samples
+
+#include "bench_util.h"
+#include "bench_world.h"
+#include "world/light_engine.h"
+
+namespace
+{
+    constexpr int AREA = 8;       // AREA x AREA chunks
+    constexpr int RELIGHTS = 50;  // Repeated full lights of the centre chunk
+    constexpr int EDITS = 2000;   // Per edit kind, every edit is undone again
+
+    // Keeps edits away from the unloaded outside, where light has nowhere to go
+    int randomCoordinate(bench::Rng &rng)
+    {
+        int extent = bench::worldExtent(AREA, 8);
+        return rng.range(-extent, extent);
+    }
+
+    enum class Edit
+    {
+        SURFACE_BLOCK, // Stone placed on the surface, then broken
+        SURFACE_LAMP,  // Lamp placed on the surface, then broken
+        BREAK_SURFACE, // Topmost block of a column broken, then put back
+    };
+
+    void measureEdits(const char *label, World &world, LightEngine &light, Edit edit)
+    {
+        bench::Rng rng;
+        std::vector<double> samples;
+        samples.reserve(EDITS * 2);
+        LightEngine::Stats before = light.stats();
+        for (int i = 0; i < EDITS; ++i)
+        {
+            int x = randomCoordinate(rng);
+            int z = randomCoordinate(rng);
+            int y = bench::surfaceY(world, x, z) + (edit == Edit::BREAK_SURFACE ? 0 : 1);
+            BlockID original = world.getBlock(x, y, z);
+            BlockID changed = edit == Edit::BREAK_SURFACE ? Blocks::AIR : edit == Edit::SURFACE_LAMP ? Blocks::LAMP : Blocks::STONE;
+            if (y <= 0 || original == changed)
+                continue;
+
+            for (BlockID id : {changed, original})
+            {
+                bench::Timer timer;
+                light.setBlock(world, x, y, z, id);
+                samples.push_back(timer.micros());
+            }
+        }
+        LightEngine::Stats after = light.stats();
+        double visited = double(after.nodesAdded - before.nodesAdded + after.nodesRemoved - before.nodesRemoved);
+        std::size_t count = samples.size();
+        std::printf("%-28s %10.1f us %10.1f us %10.1f us %12.0f\n", label, bench::percentile(samples, 50), bench::percentile(samples, 99),
+                    bench::percentile(samples, 100), visited / double(count));
+    }
+}
+
+int main()
+{
+    World world;
+    bench::generateWorld(world, AREA);
+    LightEngine light;
+
+    bench::header("Full chunk light (on load)");
+    bench::Timer all;
+    for (const auto &[pos, chunk] : world.chunks())
+        light.lightChunk(world, pos);
+    double allMillis = all.millis();
+    std::printf("%-40s %8.3f ms per chunk (%d chunks, neighbours lit or not)\n", "first light, chunk by chunk", allMillis / (AREA * AREA),
+                AREA * AREA);
+
+    std::vector<double> samples;
+    for (int i = 0; i < RELIGHTS; ++i)
+    {
+        bench::Timer timer;
+        light.lightChunk(world, {0, 0});
+        samples.push_back(timer.millis());
+    }
+    std::printf("%-40s %8.3f ms median, %.3f ms p99\n", "relight of a chunk with lit neighbours", bench::percentile(samples, 50),
+                bench::percentile(samples, 99));
+
+    std::size_t lightBytes = 0;
+    for (const auto &[pos, chunk] : world.chunks())
+        for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+            lightBytes += chunk->skyLightSection(sectionY).memoryUsage() + chunk->blockLightSection(sectionY).memoryUsage();
+    std::printf("%-40s %8.1f KiB per chunk\n", "light nibbles (uniform sections free)", double(lightBytes) / 1024.0 / (AREA * AREA));
+
+    bench::header("Single block update latency (incremental relight)");
+    std::printf("%-28s %13s %13s %13s %12s\n", "edit", "p50", "p99", "max", "voxels/edit");
+    measureEdits("stone on the surface", world, light, Edit::SURFACE_BLOCK);
+    measureEdits("lamp on the surface", world, light, Edit::SURFACE_LAMP);
+    measureEdits("surface block broken", world, light, Edit::BREAK_SURFACE);
+    return 0;
+}
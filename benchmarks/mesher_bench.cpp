@@ -0,0 +1,151 @@
+// Headless meshing benchmark: triangles emitted and meshing time per chunk for
+// flat, noisy and cave-heavy test chunks, with and without greedy merging, and
+// the cost of baking ambient occlusion into the vertices.
+
+#include <cmath>  // For std::sin, std::cos
+#include <cstdio> // For std::printf
+#include <vector> // For the timing samples
+
+#include "bench_util.h"
+#include "mesh/chunk_mesher.h"
+
+namespace
+{
+    constexpr int TERRAIN_HEIGHT = 64;
+
+    // Integer hash in [0, 1) used as cheap deterministic noise
+    float hashNoise(int x, int y, int z)
+    {
+        unsigned h = unsigned(x) * 374761393u + unsigned(y) * 668265263u + unsigned(z) * 2147483647u;
+        h = (h ^ (h >> 13)) * 1274126177u;
+        return float((h ^ (h >> 16)) & 0xFFFF) / 65536.0f;
+    }
+
+    enum class Kind
+    {
+        FLAT,
+        NOISY,
+        CAVES
+    };
+
+    BlockID blockAt(Kind kind, int x, int y, int z)
+    {
+        int height = TERRAIN_HEIGHT;
+        if (kind != Kind::FLAT)
+            height += int(10.0f * std::sin(x * 0.21f) + 8.0f * std::cos(z * 0.17f) + 4.0f * hashNoise(x, 0, z));
+        if (y > height)
+            return Blocks::AIR;
+
+        if (kind == Kind::CAVES)
+        {
+            // Overlapping sine tunnels carve out roughly a third of the underground
+            float d = std::sin(x * 0.31f) + std::sin(y * 0.27f + x * 0.05f) + std::sin(z * 0.29f + y * 0.07f);
+            if (d > 0.9f && y > 2)
+                return Blocks::AIR;
+        }
+
+        if (y == height)
+            return Blocks::GRASS;
+        if (y > height - 4)
+            return Blocks::DIRT;
+        if (kind == Kind::NOISY && hashNoise(x, y, z) < 0.08f)
+            return hashNoise(z, x, y) < 0.5f ? Blocks::GRAVEL : Blocks::GOLD_ORE;
+        return Blocks::STONE;
+    }
+
+    // 3x3 chunks so the centre chunk has real neighbours on every side
+    void buildWorld(World &world, Kind kind)
+    {
+        for (int cz = -1; cz <= 1; ++cz)
+            for (int cx = -1; cx <= 1; ++cx)
+            {
+                Chunk &chunk = world.getOrCreateChunk({cx, cz});
+                for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                    for (int z = 0; z < CHUNK_SIZE; ++z)
+                        for (int x = 0; x < CHUNK_SIZE; ++x)
+                            if (BlockID id = blockAt(kind, cx * CHUNK_SIZE + x, y, cz * CHUNK_SIZE + z))
+                                chunk.setBlock(x, y, z, id);
+            }
+    }
+
+    struct Variant
+    {
+        const char *name;
+        bool greedy;
+        bool ambientOcclusion;
+    };
+    const Variant VARIANTS[] = {{"culled", false, false}, {"greedy", true, false}, {"greedy+AO", true, true}};
+    constexpr int VARIANT_COUNT = 3;
+    constexpr int GREEDY = 1; // Index of the AO baseline
+    constexpr int GREEDY_AO = 2;
+    constexpr int REPETITIONS = 31; // Every repetition meshes the chunk once per variant, interleaved
+
+    struct Result
+    {
+        std::size_t triangles = 0;
+        std::size_t packedBytes = 0;
+        std::size_t floatBytes = 0;
+    };
+
+    double meshChunk(const World &world, const Variant &variant, Result &result)
+    {
+        MeshOptions options;
+        options.greedy = variant.greedy;
+        options.ambientOcclusion = variant.ambientOcclusion;
+
+        ChunkMesh mesh;
+        result = Result{};
+        bench::Timer timer;
+        for (int s = 0; s < SECTIONS_PER_CHUNK; ++s)
+        {
+            buildSectionMesh(world, {0, 0}, s, mesh, options);
+            result.triangles += mesh.triangleCount();
+            result.packedBytes += mesh.byteSize();
+            // What the same mesh took with 8-float vertices and 32-bit indices
+            result.floatBytes += mesh.vertexCount() * 8 * sizeof(float) + mesh.indices.size() * sizeof(std::uint32_t);
+        }
+        return timer.millis();
+    }
+
+    void run(const char *label, Kind kind)
+    {
+        World world;
+        buildWorld(world, kind);
+
+        // The variants take turns, so drift in clock speed or cache state hits them all alike; the AO overhead
+        // is the median of the per repetition ratios rather than the ratio of two separate runs
+        Result results[VARIANT_COUNT];
+        std::vector<double> millis[VARIANT_COUNT];
+        std::vector<double> aoRatios;
+        for (int r = 0; r < REPETITIONS; ++r)
+        {
+            double repetition[VARIANT_COUNT];
+            for (int v = 0; v < VARIANT_COUNT; ++v)
+            {
+                repetition[v] = meshChunk(world, VARIANTS[v], results[v]);
+                millis[v].push_back(repetition[v]);
+            }
+            aoRatios.push_back(repetition[GREEDY_AO] / repetition[GREEDY]);
+        }
+
+        for (int v = 0; v < VARIANT_COUNT; ++v)
+        {
+            std::printf("%-12s %-10s %8zu triangles/chunk  %8.3f ms/chunk  %8.1f KiB (float layout %8.1f KiB)", label, VARIANTS[v].name,
+                        results[v].triangles, bench::percentile(millis[v], 50), results[v].packedBytes / 1024.0,
+                        results[v].floatBytes / 1024.0);
+            if (v == GREEDY_AO)
+                std::printf("  AO %+.1f%% time (median of %d, p10 %+.1f%%, p90 %+.1f%%)", (bench::percentile(aoRatios, 50) - 1.0) * 100.0,
+                            REPETITIONS, (bench::percentile(aoRatios, 10) - 1.0) * 100.0, (bench::percentile(aoRatios, 90) - 1.0) * 100.0);
+            std::printf("\n");
+        }
+    }
+}
+
+int main()
+{
+    bench::header("Meshing one 16x256x16 chunk (median)");
+    run("flat", Kind::FLAT);
+    run("noisy", Kind::NOISY);
+    run("caves", Kind::CAVES);
+    return 0;
+}
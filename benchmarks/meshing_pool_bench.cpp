@@ -0,0 +1,102 @@
+// Stress test for the meshing pool: meshes every section of a large world and reports
+// how throughput scales from 1 to N worker threads.
+
+#include <cmath>  // For std::sin, std::cos
+#include <cstdio> // For std::printf
+#include <thread> // For std::thread::hardware_concurrency
+
+#include "bench_util.h"
+#include "mesh/meshing_pool.h"
+
+namespace
+{
+    constexpr int WORLD_RADIUS = 12; // 24x24 chunks
+
+    void buildWorld(World &world)
+    {
+        for (int cz = -WORLD_RADIUS; cz < WORLD_RADIUS; ++cz)
+            for (int cx = -WORLD_RADIUS; cx < WORLD_RADIUS; ++cx)
+            {
+                Chunk &chunk = world.getOrCreateChunk({cx, cz});
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                    {
+                        int wx = cx * CHUNK_SIZE + x;
+                        int wz = cz * CHUNK_SIZE + z;
+                        int height = 60 + int(12.0f * std::sin(wx * 0.07f) + 9.0f * std::cos(wz * 0.05f));
+                        for (int y = 0; y <= height; ++y)
+                        {
+                            // Sparse tunnels so sections have real interior faces
+                            if (y > 4 && y < height - 6 && std::sin(wx * 0.3f) + std::sin(y * 0.3f) + std::sin(wz * 0.3f) > 1.5f)
+                                continue;
+                            chunk.setBlock(x, y, z, y == height ? Blocks::GRASS : (y > height - 4 ? Blocks::DIRT : Blocks::STONE));
+                        }
+                    }
+            }
+    }
+
+    // Snapshots every non-empty section, then meshes them all with the given number of workers
+    void run(const World &world, unsigned threads, double &baselineSeconds)
+    {
+        std::vector<MeshJob> jobs;
+        for (const auto &[pos, chunk] : world.chunks())
+            for (int s = 0; s < SECTIONS_PER_CHUNK; ++s)
+            {
+                auto blocks = std::make_unique<PaddedSection>();
+                if (!gatherSection(world, pos, s, *blocks))
+                    continue;
+                MeshJob job;
+                job.chunk = pos;
+                job.sectionY = s;
+                job.blocks = std::move(blocks);
+                jobs.push_back(std::move(job));
+            }
+        std::size_t count = jobs.size();
+
+        JobSystem jobSystem(threads);
+        MeshingPool pool(jobSystem);
+        bench::Timer timer;
+        for (MeshJob &job : jobs)
+            pool.submit(std::move(job));
+
+        // Drain like the render thread would
+        std::size_t received = 0;
+        std::size_t triangles = 0;
+        MeshResult result;
+        while (received < count)
+        {
+            if (pool.tryPopResult(result))
+            {
+                ++received;
+                triangles += result.mesh.triangleCount();
+            }
+            else
+                std::this_thread::yield();
+        }
+        double seconds = timer.seconds();
+        if (threads == 1)
+            baselineSeconds = seconds;
+
+        std::printf("%2u threads  %6zu sections  %8.1f ms  %9.0f sections/s  speedup %.2fx  (%zu triangles)\n", threads, count,
+                    seconds * 1e3, count / seconds, baselineSeconds / seconds, triangles);
+    }
+}
+
+int main()
+{
+    World world;
+    buildWorld(world);
+
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads == 0)
+        hardwareThreads = 1;
+
+    bench::header("Meshing pool scaling");
+    std::printf("%zu chunks, %u hardware threads\n", world.chunkCount(), hardwareThreads);
+
+    double baseline = 0.0;
+    for (unsigned threads = 1; threads < hardwareThreads; threads *= 2)
+        run(world, threads, baseline);
+    run(world, hardwareThreads, baseline);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Compares the palette-compressed section storage against the previous dense layout
+// (one 16-bit ID per voxel) and measures read/write latency at every index width.
+
+#include <cstdio> // For std::printf
+
+#include "bench_util.h"
+#include "world/chunk.h"
+
+namespace
+{
+    // Bytes the same chunk took with one dense std::array<BlockID, 4096> per allocated section
+    std::size_t denseBytes(const Chunk &chunk)
+    {
+        return sizeof(Chunk) + std::size_t(chunk.allocatedSections()) * (SECTION_VOLUME * sizeof(BlockID) + sizeof(int));
+    }
+
+    void fillTerrain(Chunk &chunk, int height)
+    {
+        for (int y = 0; y <= height; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    chunk.setBlock(x, y, z, y == height ? Blocks::GRASS : (y > height - 4 ? Blocks::DIRT : Blocks::STONE));
+    }
+
+    // Terrain with ore pockets and gravel mixed into the stone
+    void fillMixed(Chunk &chunk, int height, bench::Rng &rng)
+    {
+        fillTerrain(chunk, height);
+        const BlockID extras[] = {Blocks::GRAVEL, Blocks::GOLD_ORE, Blocks::COBBLESTONE, Blocks::DIRT};
+        for (int i = 0; i < 1500; ++i)
+            chunk.setBlock(rng.range(0, CHUNK_SIZE), rng.range(0, height - 4), rng.range(0, CHUNK_SIZE), extras[rng.range(0, 4)]);
+    }
+
+    // Worst case: every voxel of the lower sections gets one of `types` random IDs
+    void fillRandom(Chunk &chunk, int height, int types, bench::Rng &rng)
+    {
+        for (int y = 0; y < height; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    chunk.setBlock(x, y, z, BlockID(1 + rng.range(0, types)));
+    }
+
+    void report(const char *label, const Chunk &chunk)
+    {
+        std::size_t dense = denseBytes(chunk);
+        std::size_t packed = chunk.memoryUsage();
+        std::printf("%-34s %9zu -> %9zu bytes  (%5.1fx smaller)  bits:", label, dense, packed, double(dense) / double(packed));
+        for (int s = 0; s < SECTIONS_PER_CHUNK; ++s)
+            if (const ChunkSection *section = chunk.section(s))
+                std::printf(" %d", section->bitsPerBlock());
+        std::printf("\n");
+    }
+
+    void memoryReport()
+    {
+        bench::header("Bytes per chunk: dense 16-bit -> palette");
+        bench::Rng rng;
+
+        Chunk solid({0, 0});
+        fillTerrain(solid, CHUNK_HEIGHT - 1);
+        report("completely filled", solid);
+
+        Chunk flat({0, 0});
+        fillTerrain(flat, 64);
+        report("terrain (height 64)", flat);
+
+        Chunk mixed({0, 0});
+        fillMixed(mixed, 64, rng);
+        report("terrain with ores and gravel", mixed);
+
+        Chunk noisy({0, 0});
+        fillRandom(noisy, 64, 12, rng);
+        report("12 random block types", noisy);
+
+        Chunk worst({0, 0});
+        fillRandom(worst, 64, 1000, rng);
+        report("1000 random block types", worst);
+    }
+
+    // Random reads/writes inside one section prepared with the given number of block types
+    void latency(int types)
+    {
+        bench::Rng rng;
+        ChunkSection section;
+        for (int y = 0; y < SECTION_SIZE; ++y)
+            for (int z = 0; z < SECTION_SIZE; ++z)
+                for (int x = 0; x < SECTION_SIZE; ++x)
+                    section.setBlock(x, y, z, types == 1 ? BlockID(Blocks::STONE) : BlockID(1 + rng.range(0, types)));
+
+        const int count = 8'000'000;
+        std::vector<std::uint16_t> positions(count);
+        for (auto &p : positions)
+            p = std::uint16_t(rng.range(0, SECTION_VOLUME));
+
+        bench::Timer timer;
+        unsigned sum = 0;
+        for (std::uint16_t p : positions)
+            sum += section.getBlock(p & 15, p >> 8, (p >> 4) & 15);
+        bench::doNotOptimize(sum);
+        double readNs = timer.seconds() * 1e9 / count;
+
+        // Writes only pick IDs already in the palette so the width stays the same
+        timer.reset();
+        for (int i = 0; i < count; ++i)
+        {
+            std::uint16_t p = positions[i];
+            section.setBlock(p & 15, p >> 8, (p >> 4) & 15, types == 1 ? BlockID(Blocks::STONE) : BlockID(1 + (i % types)));
+        }
+        double writeNs = timer.seconds() * 1e9 / count;
+
+        std::printf("%5d types  %2d bits/block   read %6.2f ns   write %6.2f ns\n", types, section.bitsPerBlock(), readNs, writeNs);
+    }
+}
+
+int main()
+{
+    memoryReport();
+
+    bench::header("Random access latency inside one section");
+    for (int types : {1, 2, 4, 16, 256, 1000})
+        latency(types);
+    return 0;
+}
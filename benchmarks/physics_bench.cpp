@@ -0,0 +1,84 @@
+// Swept AABB collision against generated terrain: thousands of entities wander around, walking up single
+// block ledges, turning when a wall stops them and falling into whatever is below, stepped at the game's
+// 30 Hz tick. Reports the time per tick serially and spread over the job system, and how it scales with
+// the entity count.
+
+#include <cstdint> // For the walker seeds
+#include <cstdio>  // For std::printf
+#include <vector>  // For the entities
+
+#include "bench_util.h"
+#include "bench_world.h"
+#include "world/entities.h"
+
+namespace
+{
+    constexpr int AREA = 16;                   // AREA x AREA chunks
+    constexpr int TICKS = 150;
+    constexpr float WALK_SPEED = 4.3f;         // Blocks per second
+    constexpr int COUNTS[] = {1000, 10000, 50000};
+
+    // Entities start anywhere above the terrain, away from the unloaded outside
+    void spawn(std::vector<PhysicsBody> &bodies, std::vector<Mob> &walkers, int count, bench::Rng &rng)
+    {
+        int extent = bench::worldExtent(AREA, 16);
+        bodies.assign(std::size_t(count), PhysicsBody{});
+        walkers.resize(std::size_t(count));
+        for (int i = 0; i < count; ++i)
+        {
+            bodies[i].position = {float(rng.range(-extent, extent)) + 0.5f, float(CHUNK_HEIGHT - 8), float(rng.range(-extent, extent)) + 0.5f};
+            walkers[i].random = std::uint32_t(i) + 1; // xorshift never leaves 0
+        }
+    }
+
+    void think(std::vector<PhysicsBody> &bodies, std::vector<Mob> &walkers)
+    {
+        for (std::size_t i = 0; i < bodies.size(); ++i)
+            wander(walkers[i], bodies[i], WALK_SPEED);
+    }
+
+    double measure(const World &world, int count, JobSystem *jobs, int &grounded)
+    {
+        bench::Rng rng;
+        std::vector<PhysicsBody> bodies;
+        std::vector<Mob> walkers;
+        spawn(bodies, walkers, count, rng);
+        for (int tick = 0; tick < bench::SETTLE_TICKS; ++tick)
+            stepBodies(world, bodies, bench::TICK_SECONDS, {}, jobs);
+
+        std::vector<double> samples;
+        samples.reserve(TICKS);
+        for (int tick = 0; tick < TICKS; ++tick)
+        {
+            think(bodies, walkers);
+            bench::Timer timer;
+            stepBodies(world, bodies, bench::TICK_SECONDS, {}, jobs);
+            samples.push_back(timer.millis());
+        }
+        grounded = 0;
+        for (const PhysicsBody &body : bodies)
+            grounded += body.onGround;
+        return bench::percentile(samples, 50);
+    }
+}
+
+int main()
+{
+    World world;
+    bench::generateWorld(world, AREA);
+    JobSystem jobs;
+
+    bench::header("Entity physics per 30 Hz tick (median)");
+    std::printf("%-10s %12s %12s %12s %14s %10s\n", "entities", "serial", "jobs", "ns/entity", "tick budget", "on ground");
+    for (int count : COUNTS)
+    {
+        int grounded;
+        double serialMillis = measure(world, count, nullptr, grounded);
+        double parallelMillis = measure(world, count, &jobs, grounded);
+        std::printf("%-10d %9.3f ms %9.3f ms %12.1f %13.1f%% %9.1f%%\n", count, serialMillis, parallelMillis, serialMillis * 1e6 / count,
+                    100.0 * parallelMillis / (bench::TICK_SECONDS * 1000.0), 100.0 * grounded / count);
+    }
+    std::printf("(%u workers; tick budget is the job system time as a share of the %.1f ms tick)\n", jobs.workerCount(),
+                bench::TICK_SECONDS * 1000.0);
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Voxel raycasts over a generated world: short picking rays (the block under the mouse cursor, every frame),
+// long rays across the loaded area, and batches of line of sight queries between agents standing on the
+// terrain, answered serially and spread over the job system. Reports rays per second and blocks visited per ray.
+
+#include <cmath>  // For std::sin, std::cos
+#include <cstdio> // For std::printf
+#include <vector> // For the rays and query batches
+
+#include "bench_util.h"
+#include "bench_world.h"
+#include "world/voxel_raycast.h"
+
+namespace
+{
+    constexpr int AREA = 16;               // AREA x AREA chunks
+    constexpr int RAYS = 200000;           // Per ray kind
+    constexpr float PICK_REACH = 8.0f;     // Player reach when picking blocks
+    constexpr float LONG_REACH = 128.0f;
+    constexpr float SIGHT_RANGE = 48.0f;   // Agents look for targets within this distance
+    constexpr int SIGHT_QUERIES = 100000;  // Per batch
+    constexpr int SIGHT_BATCHES = 10;
+    constexpr float EYE_HEIGHT = 1.6f;
+
+    // Eye position of someone standing on a random column, away from the unloaded outside
+    Vec3 randomEye(const World &world, bench::Rng &rng, int margin)
+    {
+        int extent = bench::worldExtent(AREA, margin);
+        int x = rng.range(-extent, extent);
+        int z = rng.range(-extent, extent);
+        return {float(x) + 0.5f, float(bench::surfaceY(world, x, z) + 1) + EYE_HEIGHT, float(z) + 0.5f};
+    }
+
+    // Random direction; pitch between minPitch and maxPitch (radians, negative looks down)
+    Vec3 randomDirection(bench::Rng &rng, float minPitch, float maxPitch)
+    {
+        float yaw = float(rng.range(0, 3599)) * (6.2831853f / 3600.0f);
+        float pitch = minPitch + (maxPitch - minPitch) * float(rng.range(0, 1000)) / 1000.0f;
+        return {std::sin(yaw) * std::cos(pitch), std::sin(pitch), -std::cos(yaw) * std::cos(pitch)};
+    }
+
+    struct Ray
+    {
+        Vec3 origin;
+        Vec3 direction;
+    };
+
+    void measureRays(const char *label, const World &world, const std::vector<Ray> &rays, float reach)
+    {
+        std::uint64_t steps = 0;
+        int hits = 0;
+        bench::Timer timer;
+        for (const Ray &ray : rays)
+        {
+            RayHit hit = raycast(world, ray.origin, ray.direction, reach);
+            steps += std::uint64_t(hit.steps);
+            hits += hit.hit;
+        }
+        double seconds = timer.seconds();
+        std::printf("%-34s %10.2f Mrays/s %10.1f ns/ray %10.1f blocks/ray %8.1f%% hit\n", label, double(rays.size()) / seconds / 1e6,
+                    seconds * 1e9 / double(rays.size()), double(steps) / double(rays.size()), 100.0 * hits / double(rays.size()));
+    }
+
+    double measureSight(const World &world, const std::vector<SightQuery> &queries, std::vector<std::uint8_t> &visible, JobSystem *jobs)
+    {
+        bench::Timer timer;
+        for (int batch = 0; batch < SIGHT_BATCHES; ++batch)
+            lineOfSight(world, queries, visible, jobs);
+        return timer.seconds() / SIGHT_BATCHES;
+    }
+}
+
+int main()
+{
+    World world;
+    bench::generateWorld(world, AREA);
+    bench::Rng rng;
+
+    bench::header("Single rays (first non-air block)");
+    std::vector<Ray> picking(RAYS);
+    for (Ray &ray : picking)
+        ray = {randomEye(world, rng, 16), randomDirection(rng, -1.4f, 0.3f)};
+    measureRays("picking, reach 8", world, picking, PICK_REACH);
+
+    std::vector<Ray> longRays(RAYS);
+    for (Ray &ray : longRays)
+        ray = {randomEye(world, rng, 16), randomDirection(rng, -0.6f, 0.2f)};
+    measureRays("long, reach 128", world, longRays, LONG_REACH);
+
+    bench::header("Line of sight between agents on the terrain (batched)");
+    std::vector<SightQuery> queries(SIGHT_QUERIES);
+    for (SightQuery &query : queries)
+    {
+        query.from = randomEye(world, rng, int(SIGHT_RANGE) + 8);
+        Vec3 offset = randomDirection(rng, 0.0f, 0.0f) * (SIGHT_RANGE * float(rng.range(1, 100)) / 100.0f);
+        int x = int(std::floor(query.from.x + offset.x));
+        int z = int(std::floor(query.from.z + offset.z));
+        query.to = {float(x) + 0.5f, float(bench::surfaceY(world, x, z) + 1) + EYE_HEIGHT, float(z) + 0.5f};
+    }
+
+    std::vector<std::uint8_t> serialVisible, parallelVisible;
+    double serialSeconds = measureSight(world, queries, serialVisible, nullptr);
+    JobSystem jobs;
+    double parallelSeconds = measureSight(world, queries, parallelVisible, &jobs);
+
+    int visibleCount = 0;
+    for (std::uint8_t visible : serialVisible)
+        visibleCount += visible;
+    std::printf("%-34s %10.2f Mrays/s %10.2f ms per %d queries\n", "serial", SIGHT_QUERIES / serialSeconds / 1e6, serialSeconds * 1e3,
+                SIGHT_QUERIES);
+    std::printf("%-34s %10.2f Mrays/s %10.2f ms per %d queries (%u workers, %.2fx)\n", "job system", SIGHT_QUERIES / parallelSeconds / 1e6,
+                parallelSeconds * 1e3, SIGHT_QUERIES, jobs.workerCount(), serialSeconds / parallelSeconds);
+    std::printf("%.1f%% of the targets visible, results %s\n", 100.0 * visibleCount / SIGHT_QUERIES,
+                serialVisible == parallelVisible ? "match" : "DIFFER");
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Region file persistence: save throughput through the async saver, then chunk load latency with a cold
+// page cache (fresh mapping, file pages evicted) and a warm one.
+//
+// Usage: region_bench [directory]   (default: a temporary directory; pass a path on the disk you care about)
+
+#include <algorithm>  // For std::shuffle
+#include <cstdio>     // For std::printf
+#include <filesystem> // For the scratch directory
+#include <random>     // For std::mt19937
+#include <vector>     // For chunks and latency samples
+
+#include <fcntl.h>  // For open, posix_fadvise
+#include <unistd.h> // For close
+
+#include "bench_util.h"
+#include "storage/chunk_saver.h"
+#include "world/terrain_generator.h"
+
+namespace
+{
+    constexpr int SIDE = REGION_SIZE; // Exactly one region of chunks
+    constexpr std::uint64_t SEED = 1337;
+
+    // Asks the kernel to drop the cached pages of every region file (works without root once they are synced)
+    void evictFromPageCache(const std::string &directory)
+    {
+        for (const auto &file : std::filesystem::directory_iterator(directory))
+        {
+            int fd = open(file.path().c_str(), O_RDONLY);
+            if (fd < 0)
+                continue;
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+    }
+
+    bool sameBlocks(const Chunk &a, const Chunk &b)
+    {
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    if (a.getBlock(x, y, z) != b.getBlock(x, y, z))
+                        return false;
+        return true;
+    }
+
+    // Loads every chunk in a shuffled order and reports the latency distribution; false if any chunk differs
+    bool loadAll(const char *label, RegionStorage &storage, const std::vector<std::unique_ptr<Chunk>> &originals)
+    {
+        std::vector<std::size_t> order(originals.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+        std::vector<double> micros;
+        std::size_t mismatches = 0;
+        bench::Timer total;
+        for (std::size_t i : order)
+        {
+            bench::Timer timer;
+            std::unique_ptr<Chunk> chunk = storage.load(originals[i]->position());
+            micros.push_back(timer.micros());
+            if (!chunk || !sameBlocks(*chunk, *originals[i]))
+                ++mismatches;
+        }
+        double seconds = total.seconds(); // Includes the block comparison, latencies below do not
+
+        double sum = 0.0;
+        for (double m : micros)
+            sum += m;
+        double mean = sum / double(micros.size());
+        std::printf("%-6s mean %7.1f us  p50 %7.1f us  p99 %7.1f us  max %7.1f us  (%zu chunks, %.0f ms with checks)\n", label,
+                    mean, bench::percentile(micros, 50), bench::percentile(micros, 99), bench::percentile(micros, 100),
+                    originals.size(), seconds * 1e3);
+        if (mismatches)
+            std::printf("       %zu chunks did not round-trip\n", mismatches);
+        return mismatches == 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::filesystem::path directory =
+        argc > 1 ? std::filesystem::path(argv[1]) : std::filesystem::temp_directory_path() / "spacecraft_region_bench";
+    std::filesystem::remove_all(directory);
+    std::printf("region files in %s\n", directory.c_str());
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    TerrainGenerator generator(SEED);
+    for (int cz = 0; cz < SIDE; ++cz)
+        for (int cx = 0; cx < SIDE; ++cx)
+            chunks.push_back(generator.generate(ChunkPos{cx, cz}));
+
+    // Save: time the caller pays per chunk (serialization only) and the end-to-end throughput
+    bench::header("Save");
+    std::uint64_t rawBytes = 0;
+    {
+        RegionStorage storage(directory.string());
+        ChunkSaver saver(storage);
+        bench::Timer total;
+        double callerSeconds = 0.0;
+        for (const std::unique_ptr<Chunk> &chunk : chunks)
+        {
+            bench::Timer timer;
+            saver.save(*chunk);
+            callerSeconds += timer.seconds();
+
+            std::vector<std::uint8_t> data;
+            chunk->serialize(data);
+            rawBytes += data.size();
+        }
+        saver.flush();
+        double seconds = total.seconds();
+
+        std::size_t fileBytes = 0;
+        for (const auto &file : std::filesystem::directory_iterator(directory))
+            fileBytes += file.file_size();
+        std::printf("caller cost      %8.1f us per chunk (serialize + enqueue)\n", callerSeconds * 1e6 / double(chunks.size()));
+        std::printf("throughput       %8.1f chunks/s, %.1f MB/s uncompressed, %.1f MB/s written\n",
+                    double(chunks.size()) / seconds, double(rawBytes) / seconds / 1e6, double(storage.bytesWritten()) / seconds / 1e6);
+        std::printf("size             %8.1f KiB raw per chunk, %.1f KiB compressed, %.1f KiB on disk (ratio %.1fx)\n",
+                    double(rawBytes) / 1024.0 / double(chunks.size()), double(storage.bytesWritten()) / 1024.0 / double(chunks.size()),
+                    double(fileBytes) / 1024.0 / double(chunks.size()), double(rawBytes) / double(storage.bytesWritten()));
+        if (saver.failures())
+        {
+            std::printf("%zu chunks failed to save\n", saver.failures());
+            return 1;
+        }
+    }
+
+    bench::header("Load");
+    evictFromPageCache(directory.string());
+    RegionStorage storage(directory.string());
+    bool ok = loadAll("cold", storage, chunks);
+    ok = loadAll("warm", storage, chunks) && ok;
+
+    std::filesystem::remove_all(directory);
+    return ok ? 0 : 1;
+}
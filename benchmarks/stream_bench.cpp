@@ -0,0 +1,222 @@
+// Frame time of streaming per-frame vertex data: 10k quads moving every frame (40k vertices, 640 KiB),
+// uploaded with a one-shot glBufferData per frame (the old way), through the StreamBuffer 3.3 fallback
+// (orphaning + glBufferSubData) and through its persistent-mapped ring (GL 4.4). Frames are not
+// synchronised with glFinish, so any wait for the GPU shows up in the frame time.
+// Needs an OpenGL context, so it opens a hidden window (4.4 if available, else 3.3).
+//
+// Usage: stream_bench
+
+#include <glad/glad.h>  // For OpenGL functions
+#include <GLFW/glfw3.h> // For the hidden window and context
+
+#include <cmath>   // For std::sin, std::cos
+#include <cstdint> // For std::uint32_t
+#include <cstdio>  // For std::printf
+#include <utility> // For std::pair
+#include <vector>  // For samples and staging
+
+#include "bench_util.h"
+#include "render/stream_buffer.h"
+
+namespace
+{
+    constexpr int QUADS = 10000;
+    constexpr int VERTICES = QUADS * 4;
+    constexpr int FRAMES = 500;
+
+    struct QuadVertex
+    {
+        float x, y;
+        std::uint32_t color;
+        std::uint32_t padding; // 16 bytes, so ring offsets are whole vertices
+    };
+
+    const char *VERTEX_SHADER = R"(#version 330 core
+layout(location=0) in vec2 aPos;
+layout(location=1) in vec4 aColor;
+out vec4 color;
+void main()
+{
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    color = aColor;
+})";
+
+    const char *FRAGMENT_SHADER = R"(#version 330 core
+in vec4 color;
+out vec4 fragColor;
+void main()
+{
+    fragColor = color;
+})";
+
+    GLFWwindow *createHiddenWindow(int major, int minor)
+    {
+        glfwDefaultWindowHints();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        return glfwCreateWindow(512, 512, "stream_bench", NULL, NULL);
+    }
+
+    GLuint compileProgram()
+    {
+        GLuint program = glCreateProgram();
+        for (auto [type, source] : {std::pair<GLenum, const char *>{GL_VERTEX_SHADER, VERTEX_SHADER}, {GL_FRAGMENT_SHADER, FRAGMENT_SHADER}})
+        {
+            GLuint shader = glCreateShader(type);
+            glShaderSource(shader, 1, &source, nullptr);
+            glCompileShader(shader);
+            glAttachShader(program, shader);
+            glDeleteShader(shader);
+        }
+        glLinkProgram(program);
+        return program;
+    }
+
+    // The synthetic scene: every quad circles around its own centre
+    void writeQuads(QuadVertex *out, int frame)
+    {
+        for (int i = 0; i < QUADS; ++i)
+        {
+            float cx = float(i % 100) / 50.0f - 0.99f;
+            float cy = float(i / 100) / 50.0f - 0.99f;
+            float angle = float(frame) * 0.05f + float(i) * 0.1f;
+            float x = cx + std::cos(angle) * 0.005f;
+            float y = cy + std::sin(angle) * 0.005f;
+            std::uint32_t color = 0xFF000000u | std::uint32_t(i * 2654435761u >> 8);
+            const float size = 0.008f;
+            out[i * 4 + 0] = {x, y, color, 0};
+            out[i * 4 + 1] = {x + size, y, color, 0};
+            out[i * 4 + 2] = {x + size, y + size, color, 0};
+            out[i * 4 + 3] = {x, y + size, color, 0};
+        }
+    }
+
+    void setVertexLayout(GLuint buffer)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void *)0);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadVertex), (void *)(2 * sizeof(float)));
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+    }
+
+    void report(const char *label, std::vector<double> &samples, double totalSeconds, const StreamBuffer::Stats *stats)
+    {
+        std::printf("%-36s %7.3f ms median %7.3f ms p99 %8.0f frames/s", label, bench::percentile(samples, 50), bench::percentile(samples, 99),
+                    double(FRAMES) / totalSeconds);
+        if (stats)
+            std::printf("  %llu stalls (%.2f ms)", static_cast<unsigned long long>(stats->stalls), stats->stallMillis);
+        std::printf("\n");
+    }
+
+    void drawQuads(GLint baseVertex)
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawElementsBaseVertex(GL_TRIANGLES, QUADS * 6, GL_UNSIGNED_SHORT, nullptr, baseVertex);
+        glFlush();
+    }
+
+    void measureBufferData(GLuint vao)
+    {
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindVertexArray(vao);
+        setVertexLayout(buffer);
+        std::vector<QuadVertex> staging(VERTICES);
+        std::vector<double> samples;
+        bench::Timer total;
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            bench::Timer timer;
+            writeQuads(staging.data(), frame);
+            glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(staging.size() * sizeof(QuadVertex)), staging.data(), GL_STREAM_DRAW);
+            drawQuads(0);
+            samples.push_back(timer.millis());
+        }
+        glFinish();
+        report("glBufferData per frame (before)", samples, total.seconds(), nullptr);
+        glDeleteBuffers(1, &buffer);
+    }
+
+    void measureStream(GLuint vao, GLADloadproc loader, bool persistent)
+    {
+        StreamBuffer stream(GL_ARRAY_BUFFER, VERTICES * sizeof(QuadVertex), loader, persistent);
+        if (persistent && !stream.persistent())
+        {
+            std::printf("%-36s not supported by this driver\n", "StreamBuffer, persistent mapped");
+            return;
+        }
+        glBindVertexArray(vao);
+        setVertexLayout(stream.buffer());
+        std::vector<double> samples;
+        bench::Timer total;
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            bench::Timer timer;
+            stream.beginFrame();
+            StreamBuffer::Allocation allocation = stream.allocate(VERTICES * sizeof(QuadVertex), sizeof(QuadVertex));
+            writeQuads(static_cast<QuadVertex *>(allocation.data), frame);
+            stream.flush();
+            drawQuads(GLint(allocation.offset / GLintptr(sizeof(QuadVertex))));
+            stream.endFrame();
+            samples.push_back(timer.millis());
+        }
+        glFinish();
+        report(persistent ? "StreamBuffer, persistent mapped" : "StreamBuffer, orphaning fallback", samples, total.seconds(), &stream.stats());
+    }
+}
+
+int main()
+{
+    if (!glfwInit())
+    {
+        std::printf("Failed to initialize GLFW\n");
+        return 1;
+    }
+    GLFWwindow *window = createHiddenWindow(4, 4);
+    if (!window)
+        window = createHiddenWindow(3, 3);
+    if (!window)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::printf("Failed to initialize GLAD\n");
+        glfwTerminate();
+        return 1;
+    }
+
+    GLuint program = compileProgram();
+    glUseProgram(program);
+
+    // Static index buffer shared by every mode: two triangles per quad
+    std::vector<std::uint16_t> indices;
+    for (int i = 0; i < QUADS; ++i)
+        for (int corner : {0, 1, 2, 2, 3, 0})
+            indices.push_back(std::uint16_t(i * 4 + corner));
+    GLuint vao = 0, ebo = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indices.size() * sizeof(std::uint16_t)), indices.data(), GL_STATIC_DRAW);
+
+    bench::header("10k dynamic quads, CPU time per frame");
+    std::printf("GL %s\n", reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+    measureBufferData(vao);
+    measureStream(vao, (GLADloadproc)glfwGetProcAddress, false);
+    measureStream(vao, (GLADloadproc)glfwGetProcAddress, true);
+
+    glDeleteBuffers(1, &ebo);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteProgram(program);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Terrain generation: noise kernel throughput per instruction set, chunks generated per second on one thread
+// and on the job system, and a check that the SIMD paths produce exactly the scalar output.
+
+#include <cstdio>  // For std::printf
+#include <cstring> // For std::memcmp
+#include <thread>  // For std::thread::hardware_concurrency
+#include <vector>  // For sample buffers and generated chunks
+
+#include "bench_util.h"
+#include "core/job_system.h"
+#include "world/terrain_generator.h"
+
+namespace
+{
+    constexpr std::uint64_t SEED = 1337;
+    constexpr int AREA = 8;                  // AREA x AREA chunks per generation run
+    constexpr int SAMPLES = 1 << 16;         // Points per noise kernel run
+    constexpr FbmParams FBM = {4, 1.0f / 64.0f, 2.0f, 0.5f};
+
+    std::vector<SimdLevel> supportedLevels()
+    {
+        std::vector<SimdLevel> levels = {SimdLevel::SCALAR};
+        SimdLevel best = detectSimdLevel();
+        if (best >= SimdLevel::SSE41)
+            levels.push_back(SimdLevel::SSE41);
+        if (best >= SimdLevel::AVX2)
+            levels.push_back(SimdLevel::AVX2);
+        return levels;
+    }
+
+    // Random points over a wide range, negative coordinates and fractions included
+    void randomPoints(std::vector<float> &x, std::vector<float> &y, std::vector<float> &z)
+    {
+        bench::Rng rng;
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            x[i] = float(rng.range(-200000, 200000)) * 0.37f;
+            y[i] = float(rng.range(0, 256 * 16)) * 0.0625f;
+            z[i] = float(rng.range(-200000, 200000)) * 0.61f;
+        }
+    }
+
+    std::vector<std::unique_ptr<Chunk>> generateArea(const TerrainGenerator &generator)
+    {
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        for (int cz = 0; cz < AREA; ++cz)
+            for (int cx = 0; cx < AREA; ++cx)
+                chunks.push_back(generator.generate(ChunkPos{cx - AREA / 2, cz - AREA / 2}));
+        return chunks;
+    }
+
+    bool sameBlocks(const Chunk &a, const Chunk &b)
+    {
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    if (a.getBlock(x, y, z) != b.getBlock(x, y, z))
+                        return false;
+        return true;
+    }
+
+    bool checkIdentical(const std::vector<SimdLevel> &levels)
+    {
+        bench::header("SIMD vs scalar output");
+        PerlinNoise noise(SEED);
+        std::vector<float> x(SAMPLES), y(SAMPLES), z(SAMPLES), reference(SAMPLES), out(SAMPLES);
+        randomPoints(x, y, z);
+
+        std::vector<float> reference3(SAMPLES);
+        noise.fbm2(x.data(), z.data(), reference.data(), SAMPLES, FBM, SimdLevel::SCALAR);
+        noise.fbm3(x.data(), y.data(), z.data(), reference3.data(), SAMPLES, FBM, SimdLevel::SCALAR);
+        std::vector<std::unique_ptr<Chunk>> referenceChunks = generateArea(TerrainGenerator(SEED, SimdLevel::SCALAR));
+
+        bool allIdentical = true;
+        for (SimdLevel level : levels)
+        {
+            if (level == SimdLevel::SCALAR)
+                continue;
+            noise.fbm2(x.data(), z.data(), out.data(), SAMPLES, FBM, level);
+            bool same2 = std::memcmp(out.data(), reference.data(), SAMPLES * sizeof(float)) == 0;
+            noise.fbm3(x.data(), y.data(), z.data(), out.data(), SAMPLES, FBM, level);
+            bool same3 = std::memcmp(out.data(), reference3.data(), SAMPLES * sizeof(float)) == 0;
+
+            std::vector<std::unique_ptr<Chunk>> chunks = generateArea(TerrainGenerator(SEED, level));
+            bool sameChunks = true;
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+                sameChunks = sameChunks && sameBlocks(*chunks[i], *referenceChunks[i]);
+
+            std::printf("%-8s fbm2 %s  fbm3 %s  %d chunks %s\n", simdLevelName(level), same2 ? "identical" : "MISMATCH",
+                        same3 ? "identical" : "MISMATCH", AREA * AREA, sameChunks ? "identical" : "MISMATCH");
+            allIdentical = allIdentical && same2 && same3 && sameChunks;
+        }
+        if (levels.size() == 1)
+            std::printf("no SIMD level available on this CPU, nothing to compare\n");
+        return allIdentical;
+    }
+
+    void kernelThroughput(const std::vector<SimdLevel> &levels)
+    {
+        bench::header("Noise kernels (4 octaves)");
+        PerlinNoise noise(SEED);
+        std::vector<float> x(SAMPLES), y(SAMPLES), z(SAMPLES), out(SAMPLES);
+        randomPoints(x, y, z);
+
+        char label[64];
+        for (SimdLevel level : levels)
+        {
+            bench::Timer timer;
+            noise.fbm2(x.data(), z.data(), out.data(), SAMPLES, FBM, level);
+            std::snprintf(label, sizeof(label), "fbm2 %s", simdLevelName(level));
+            bench::rate(label, SAMPLES, timer.seconds(), "samples");
+            bench::doNotOptimize(out[SAMPLES / 2]);
+
+            timer.reset();
+            noise.fbm3(x.data(), y.data(), z.data(), out.data(), SAMPLES, FBM, level);
+            std::snprintf(label, sizeof(label), "fbm3 %s", simdLevelName(level));
+            bench::rate(label, SAMPLES, timer.seconds(), "samples");
+            bench::doNotOptimize(out[SAMPLES / 2]);
+        }
+    }
+
+    void singleThreaded(const std::vector<SimdLevel> &levels)
+    {
+        bench::header("Chunk generation, one thread");
+        for (SimdLevel level : levels)
+        {
+            TerrainGenerator generator(SEED, level);
+            bench::Timer timer;
+            std::vector<std::unique_ptr<Chunk>> chunks = generateArea(generator);
+            double seconds = timer.seconds();
+            std::printf("%-8s %4d chunks  %8.1f ms  %8.1f chunks/s  (%.2f ms/chunk)\n", simdLevelName(level), AREA * AREA,
+                        seconds * 1e3, AREA * AREA / seconds, seconds * 1e3 / (AREA * AREA));
+        }
+    }
+
+    void multiThreaded()
+    {
+        bench::header("Chunk generation on the job system");
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        if (hardwareThreads == 0)
+            hardwareThreads = 1;
+
+        TerrainGenerator generator(SEED);
+        constexpr int SIDE = AREA * 2;
+        double baseline = 0.0;
+        for (unsigned threads = 1;; threads = threads * 2 < hardwareThreads ? threads * 2 : hardwareThreads)
+        {
+            JobSystem jobs(threads);
+            std::vector<std::unique_ptr<Chunk>> chunks(SIDE * SIDE);
+            bench::Timer timer;
+            jobs.parallelFor(0, chunks.size(), 1, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                    chunks[i] = generator.generate(ChunkPos{int(i % SIDE) - SIDE / 2, int(i / SIDE) - SIDE / 2});
+            });
+            double seconds = timer.seconds();
+            if (threads == 1)
+                baseline = seconds;
+
+            std::printf("%2u workers  %4d chunks  %8.1f ms  %8.1f chunks/s  speedup %.2fx  (%s)\n", threads, SIDE * SIDE,
+                        seconds * 1e3, SIDE * SIDE / seconds, baseline / seconds, simdLevelName(generator.simdLevel()));
+            if (threads == hardwareThreads)
+                break;
+        }
+    }
+}
+
+int main()
+{
+    std::vector<SimdLevel> levels = supportedLevels();
+    std::printf("best SIMD level: %s\n", simdLevelName(detectSimdLevel()));
+
+    bool identical = checkIdentical(levels);
+    kernelThroughput(levels);
+    singleThreaded(levels);
+    multiThreaded();
+    return identical ? 0 : 1;
+}
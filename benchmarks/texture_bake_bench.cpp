@@ -0,0 +1,126 @@
+// Startup cost of the block textures: the JPEG path (read, stb_image decode, cut into layers, then mipmaps,
+// which the game leaves to glGenerateMipmap and is measured here as the same box filter on the CPU) against
+// mapping a baked container and reading every mip level, the bytes the driver copies at upload. Baked files
+// are measured with a warm and a cold page cache.
+//
+// Usage: texture_bake_bench [imageDirectory]   (default ../images, run from the build directory)
+
+#include <cstdio>     // For std::printf
+#include <filesystem> // For the scratch directory
+#include <string>     // For paths
+#include <utility>    // For std::pair
+#include <vector>     // For samples
+
+#include <fcntl.h>  // For open, posix_fadvise
+#include <unistd.h> // For close
+
+#include "bench_util.h"
+#include "texture/baked_texture.h"
+#include "texture/texture_atlas.h"
+
+namespace
+{
+    constexpr int LAYER_SIZE = 256;
+    constexpr int RUNS = 7;
+
+    void evictFromPageCache(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+
+    TextureLayers decodeLayers(const std::string &imageDirectory)
+    {
+        AtlasOptions options;
+        options.padding = 0;
+        return layersFromAtlas(loadOrBuildAtlas(blockTileSources(imageDirectory), options), LAYER_SIZE);
+    }
+
+    // Sums every byte of every level, standing in for the driver copying them out of the mapping
+    std::uint64_t touchLevels(const BakedTexture &baked)
+    {
+        std::uint64_t sum = 0;
+        for (int mip = 0; mip < baked.mipCount(); ++mip)
+        {
+            BakedTexture::Level level = baked.level(mip);
+            for (std::size_t i = 0; i < level.bytes; i += 8)
+                sum += level.data[i];
+        }
+        return sum;
+    }
+
+    // prepare runs before every timed run, outside the timer
+    template <typename Prepare, typename Body>
+    void measure(const char *label, Prepare prepare, Body body)
+    {
+        std::vector<double> samples;
+        for (int run = 0; run < RUNS; ++run)
+        {
+            prepare();
+            bench::Timer timer;
+            body();
+            samples.push_back(timer.millis());
+        }
+        std::printf("%-44s %9.2f ms median  %9.2f ms best\n", label, bench::percentile(samples, 50), bench::percentile(samples, 0));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string imageDirectory = argc > 1 ? argv[1] : "../images";
+    TextureLayers layers = decodeLayers(imageDirectory);
+    if (layers.empty())
+    {
+        std::printf("Failed to load the block textures from %s\n", imageDirectory.c_str());
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "spacecraft_bake_bench";
+    std::filesystem::create_directories(directory, error);
+
+    bench::header("Baking (build time)");
+    std::vector<std::pair<BakedFormat, std::string>> files;
+    for (BakedFormat format : {BakedFormat::RGBA8, BakedFormat::BC1, BakedFormat::BC3})
+    {
+        std::string path = (directory / (std::string("blocks_") + bakedFormatName(format) + ".sctx")).string();
+        bench::Timer timer;
+        if (!writeBakedTexture(path, layers, format))
+        {
+            std::printf("Failed to write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("%-6s %6.1f ms, %7zu KiB with all mip levels\n", bakedFormatName(format), timer.millis(),
+                    std::size_t(std::filesystem::file_size(path)) / 1024);
+        files.emplace_back(format, path);
+    }
+
+    bench::header("Startup (what the render thread waits for before the first textured frame)");
+    auto nothing = [] {};
+    measure("JPEG + stb_image -> layers", nothing, [&] { bench::doNotOptimize(decodeLayers(imageDirectory).pixels.data()); });
+    measure("JPEG + stb_image -> layers + mip chain", nothing, [&] { bench::doNotOptimize(buildMipChain(decodeLayers(imageDirectory)).size()); });
+    for (const auto &[format, path] : files)
+    {
+        std::string warm = std::string("baked ") + bakedFormatName(format) + ", warm page cache";
+        measure(warm.c_str(), nothing, [&]
+        {
+            BakedTexture baked;
+            baked.open(path);
+            bench::doNotOptimize(touchLevels(baked));
+        });
+        std::string cold = std::string("baked ") + bakedFormatName(format) + ", cold page cache";
+        measure(cold.c_str(), [&] { evictFromPageCache(path); }, [&]
+        {
+            BakedTexture baked;
+            baked.open(path);
+            bench::doNotOptimize(touchLevels(baked));
+        });
+    }
+
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
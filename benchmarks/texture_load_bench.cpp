@@ -0,0 +1,111 @@
+// Texture loading at startup: decode throughput for a large texture set (the game's images read once and
+// decoded many times over, standing in for hundreds of files), then the whole block texture build
+// (decode, pack, cut into layers) with an empty and a warm atlas cache. Each with 1, 4 and N threads,
+// the calling thread included since it helps while waiting.
+//
+// Usage: texture_load_bench [imageDirectory] [copies]   (default ../images and 32, run from the build directory)
+
+#include <algorithm>  // For std::max
+#include <cstdio>     // For std::printf
+#include <cstdlib>    // For std::atoi
+#include <filesystem> // For listing the images and the scratch cache
+#include <memory>     // For std::unique_ptr
+#include <string>     // For paths
+#include <thread>     // For std::thread::hardware_concurrency
+#include <utility>    // For std::move
+#include <vector>     // For file buffers
+
+#include "bench_util.h"
+#include "core/job_system.h"
+#include "texture/image_decoder.h"
+#include "texture/texture_array.h"
+#include "texture/texture_atlas.h"
+
+namespace
+{
+    constexpr int LAYER_SIZE = 256;
+
+    // A job system giving threads threads in total (workers plus the caller), or none for a single thread
+    std::unique_ptr<JobSystem> makeJobs(unsigned threads)
+    {
+        return threads > 1 ? std::make_unique<JobSystem>(threads - 1) : nullptr;
+    }
+
+    void decodeSet(const std::vector<std::vector<std::uint8_t>> &files, int copies, unsigned threads)
+    {
+        std::vector<const std::vector<std::uint8_t> *> encoded;
+        for (int copy = 0; copy < copies; ++copy)
+            for (const std::vector<std::uint8_t> &bytes : files)
+                encoded.push_back(&bytes);
+
+        std::unique_ptr<JobSystem> jobs = makeJobs(threads);
+        bench::Timer timer;
+        std::vector<DecodedImage> images = decodeImages(encoded, jobs.get());
+        double millis = timer.millis();
+
+        double megapixels = 0.0;
+        for (const DecodedImage &image : images)
+            megapixels += double(image.width) * double(image.height) / 1e6;
+        std::printf("%2u threads: %4zu images in %8.1f ms  (%6.1f images/s, %6.1f Mpx/s)\n", threads, images.size(), millis,
+                    double(images.size()) / millis * 1e3, megapixels / millis * 1e3);
+    }
+
+    void buildBlockTextures(const std::string &imageDirectory, const std::string &cacheDirectory, unsigned threads)
+    {
+        std::unique_ptr<JobSystem> jobs = makeJobs(threads);
+        AtlasOptions options;
+        options.padding = 0;
+        options.cacheDirectory = cacheDirectory;
+        options.jobs = jobs.get();
+
+        bool fromCache = false;
+        bench::Timer timer;
+        TextureLayers layers = layersFromAtlas(loadOrBuildAtlas(blockTileSources(imageDirectory), options, &fromCache), LAYER_SIZE, jobs.get());
+        double millis = timer.millis();
+        std::printf("%2u threads: %2d layers in %8.1f ms  (%s)\n", threads, layers.count(), millis, fromCache ? "atlas cached" : "decoded and packed");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string imageDirectory = argc > 1 ? argv[1] : "../images";
+    int copies = argc > 2 ? std::atoi(argv[2]) : 32;
+
+    std::vector<std::vector<std::uint8_t>> files;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(imageDirectory, error))
+    {
+        std::vector<std::uint8_t> bytes;
+        if (entry.is_regular_file() && readImageFile(entry.path().string(), bytes))
+            files.push_back(std::move(bytes));
+    }
+    if (files.empty())
+    {
+        std::printf("No images in %s\n", imageDirectory.c_str());
+        return 1;
+    }
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts = {1, 4};
+    if (hardwareThreads != 1 && hardwareThreads != 4)
+        threadCounts.push_back(hardwareThreads);
+
+    bench::header("Decode (stbi_load_from_memory over pre-read files)");
+    for (unsigned threads : threadCounts)
+        decodeSet(files, copies, threads);
+
+    std::filesystem::path cache = std::filesystem::temp_directory_path() / "spacecraft_texture_bench";
+    std::filesystem::remove_all(cache, error);
+
+    bench::header("Block texture layers, no cache");
+    for (unsigned threads : threadCounts)
+        buildBlockTextures(imageDirectory, "", threads);
+
+    bench::header("Block texture layers, warm atlas cache");
+    buildBlockTextures(imageDirectory, cache.string(), 1); // Fills the cache
+    for (unsigned threads : threadCounts)
+        buildBlockTextures(imageDirectory, cache.string(), threads);
+
+    std::filesystem::remove_all(cache, error);
+    return 0;
+}
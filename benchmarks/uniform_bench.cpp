@@ -0,0 +1,102 @@
+// Uniform updates per second: the old per-call glGetUniformLocation path against the reflected lookup table
+// (by name) and pre-resolved handles. Needs an OpenGL 3.3 context, so it opens a hidden window.
+// Run from the build directory (it loads the game shaders from ../src).
+
+#include <glad/glad.h>  // For OpenGL functions
+#include <GLFW/glfw3.h> // For the hidden window and context
+
+#include <cstdio> // For std::printf
+#include <string> // For std::string, what the old API built on every call
+
+#include "bench_util.h"
+#include "shader.h"
+
+namespace
+{
+    constexpr int UPDATES = 1000000;
+
+    template <typename Body>
+    void measure(const char *label, Body body)
+    {
+        glFinish();
+        bench::Timer timer;
+        for (int i = 0; i < UPDATES; ++i)
+            body(i);
+        glFinish(); // Count the driver work too, not just the queueing
+        bench::rate(label, UPDATES, timer.seconds(), "updates");
+    }
+}
+
+int main()
+{
+    if (!glfwInit())
+    {
+        std::printf("Failed to initialize GLFW\n");
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow *window = glfwCreateWindow(64, 64, "uniform_bench", NULL, NULL);
+    if (!window)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::printf("Failed to initialize GLAD\n");
+        glfwTerminate();
+        return 1;
+    }
+
+    {
+        Shader shader("../src/myVertexShader.vs", "../src/myFragmentShaderColors.fs");
+        shader.use();
+
+        bench::header("Reflected uniforms");
+        for (const Shader::UniformInfo &info : shader.uniforms())
+            std::printf("%-20s location %2d  type 0x%04x  size %d\n", info.name.c_str(), info.location, info.type, info.size);
+
+        Mat4 matrix = Mat4::identity();
+        UniformHandle origins = shader.uniform("sectionOrigins");
+        UniformHandle viewProjection = shader.uniform("viewProjection");
+
+        // Section origins now come from a buffer texture, so the int sampler unit stands in for the old vec3
+        bench::header("int updates (sampler unit)");
+        measure("glGetUniformLocation per call (before)", [&](int i)
+        {
+            std::string name = "sectionOrigins";
+            glUniform1i(glGetUniformLocation(shader.ID, name.c_str()), 1 + (i & 1));
+        });
+        measure("lookup table by name", [&](int i) { shader.setInt("sectionOrigins", 1 + (i & 1)); });
+        measure("pre-resolved handle", [&](int i) { shader.setInt(origins, 1 + (i & 1)); });
+
+        bench::header("mat4 updates");
+        measure("glGetUniformLocation per call (before)", [&](int i)
+        {
+            std::string name = "viewProjection";
+            matrix.m[12] = float(i);
+            glUniformMatrix4fv(glGetUniformLocation(shader.ID, name.c_str()), 1, GL_FALSE, matrix.data());
+        });
+        measure("lookup table by name", [&](int i)
+        {
+            matrix.m[12] = float(i);
+            shader.setMat4("viewProjection", matrix);
+        });
+        measure("pre-resolved handle", [&](int i)
+        {
+            matrix.m[12] = float(i);
+            shader.setMat4(viewProjection, matrix);
+        });
+
+        glDeleteProgram(shader.ID);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
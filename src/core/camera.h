@@ -0,0 +1,49 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "core/vecmath.h"
+
+// Simple yaw/pitch camera. Angles are in radians; yaw 0 looks down -Z.
+class Camera
+{
+public:
+    Vec3 position{0.0f, 0.0f, 0.0f};
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float fovY = 1.2217f; // 70 degrees
+    float zNear = 0.1f;
+    float zFar = 1000.0f;
+
+    Vec3 forward() const
+    {
+        return {std::sin(yaw) * std::cos(pitch), std::sin(pitch), -std::cos(yaw) * std::cos(pitch)};
+    }
+
+    // World space direction (not normalised) through a point of the screen, in normalised device coordinates:
+    // -1..1 from left to right and bottom to top. Used to pick blocks under the mouse cursor.
+    Vec3 rayThrough(float ndcX, float ndcY, float aspect) const
+    {
+        Vec3 f = forward();
+        Vec3 right = normalize(cross(f, Vec3{0.0f, 1.0f, 0.0f}));
+        Vec3 up = cross(right, f);
+        float halfHeight = std::tan(fovY * 0.5f);
+        return f + right * (ndcX * halfHeight * aspect) + up * (ndcY * halfHeight);
+    }
+
+    Mat4 viewMatrix() const
+    {
+        return lookAt(position, position + forward(), Vec3{0.0f, 1.0f, 0.0f});
+    }
+
+    Mat4 projectionMatrix(float aspect) const
+    {
+        return perspective(fovY, aspect, zNear, zFar);
+    }
+
+    Mat4 viewProjection(float aspect) const
+    {
+        return projectionMatrix(aspect) * viewMatrix();
+    }
+};
+
+#endif
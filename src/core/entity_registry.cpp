@@ -0,0 +1,125 @@
+#include "core/entity_registry.h"
+
+#include <algorithm> // For std::fill
+
+void EntityRegistry::destroy(Entity entity)
+{
+    if (!alive(entity))
+        return;
+    Slot &slot = m_slots[entity.index];
+    removeRow(slot.archetype, slot.row);
+    slot.archetype = NO_ARCHETYPE;
+    ++slot.generation;
+    m_freeIndices.push_back(entity.index);
+    --m_count;
+}
+
+std::size_t EntityRegistry::memoryUsage() const
+{
+    std::size_t bytes = m_slots.capacity() * sizeof(Slot) + m_freeIndices.capacity() * sizeof(std::uint32_t);
+    for (const Archetype &archetype : m_archetypes)
+    {
+        bytes += sizeof(Archetype) + archetype.entities.capacity() * sizeof(Entity);
+        for (const Column &column : archetype.columns)
+            bytes += column.data.capacity();
+    }
+    return bytes;
+}
+
+std::uint32_t EntityRegistry::archetypeFor(ComponentMask mask)
+{
+    auto found = m_archetypeByMask.find(mask);
+    if (found != m_archetypeByMask.end())
+        return found->second;
+
+    Archetype archetype;
+    archetype.mask = mask;
+    std::fill(std::begin(archetype.columnOf), std::end(archetype.columnOf), std::int8_t(-1));
+    for (int id = 0; id < MAX_COMPONENTS; ++id)
+    {
+        if (!(mask & (ComponentMask(1) << id)))
+            continue;
+        archetype.columnOf[id] = std::int8_t(archetype.columns.size());
+        archetype.columns.push_back({m_componentSizes[id], {}});
+    }
+    std::uint32_t index = std::uint32_t(m_archetypes.size());
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypeByMask.emplace(mask, index);
+    return index;
+}
+
+Entity EntityRegistry::allocate(std::uint32_t archetypeIndex)
+{
+    std::uint32_t index;
+    if (!m_freeIndices.empty())
+    {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    else
+    {
+        index = std::uint32_t(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot &slot = m_slots[index];
+    Archetype &archetype = m_archetypes[archetypeIndex];
+    Entity entity{index, slot.generation};
+    slot.archetype = archetypeIndex;
+    slot.row = std::uint32_t(archetype.entities.size());
+    archetype.entities.push_back(entity);
+    for (Column &column : archetype.columns)
+        column.data.resize(column.data.size() + column.elementSize);
+    ++m_count;
+    return entity;
+}
+
+void EntityRegistry::moveTo(Entity entity, std::uint32_t target)
+{
+    Slot &slot = m_slots[entity.index];
+    Archetype &from = m_archetypes[slot.archetype];
+    Archetype &to = m_archetypes[target];
+    std::uint32_t row = std::uint32_t(to.entities.size());
+    to.entities.push_back(entity);
+    for (int id = 0; id < MAX_COMPONENTS; ++id)
+    {
+        if (to.columnOf[id] < 0)
+            continue;
+        Column &column = to.columns[std::size_t(to.columnOf[id])];
+        column.data.resize(column.data.size() + column.elementSize);
+        if (from.columnOf[id] >= 0)
+            std::memcpy(column.data.data() + row * column.elementSize,
+                        from.columns[std::size_t(from.columnOf[id])].data.data() + slot.row * column.elementSize, column.elementSize);
+    }
+    removeRow(slot.archetype, slot.row);
+    slot.archetype = target;
+    slot.row = row;
+}
+
+void EntityRegistry::removeRow(std::uint32_t archetypeIndex, std::uint32_t row)
+{
+    Archetype &archetype = m_archetypes[archetypeIndex];
+    std::uint32_t last = std::uint32_t(archetype.entities.size() - 1);
+    if (row != last)
+    {
+        Entity moved = archetype.entities[last];
+        archetype.entities[row] = moved;
+        for (Column &column : archetype.columns)
+            std::memcpy(column.data.data() + row * column.elementSize, column.data.data() + last * column.elementSize, column.elementSize);
+        m_slots[moved.index].row = row;
+    }
+    archetype.entities.pop_back();
+    for (Column &column : archetype.columns)
+        column.data.resize(column.data.size() - column.elementSize);
+}
+
+void *EntityRegistry::rowOf(Entity entity, int componentId)
+{
+    const Slot &slot = m_slots[entity.index];
+    Archetype &archetype = m_archetypes[slot.archetype];
+    int column = archetype.columnOf[componentId];
+    if (column < 0)
+        return nullptr;
+    Column &data = archetype.columns[std::size_t(column)];
+    return data.data.data() + slot.row * data.elementSize;
+}
@@ -0,0 +1,220 @@
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include <atomic>        // For handing out component ids
+#include <cstddef>       // For std::size_t, std::max_align_t
+#include <cstdint>       // For entity indices and component masks
+#include <cstdio>        // For std::fprintf, reporting too many component types
+#include <cstdlib>       // For std::abort
+#include <cstring>       // For std::memcpy of component rows
+#include <tuple>         // For the column pointers of a query
+#include <type_traits>   // For std::is_trivially_copyable
+#include <unordered_map> // For finding archetypes by component mask
+#include <vector>        // For the tables and their columns
+
+#include "core/job_system.h"
+
+// Entities (mobs, dropped items, projectiles, ...) are just ids; their data lives in components, plain structs
+// stored structure of arrays. Every distinct set of components is an archetype with its own table: one
+// contiguous array per component plus one of entity ids, all indexed by the same row. A system iterates the
+// tables holding the components it asks for and walks their arrays front to back, touching nothing else.
+//
+// Adding or removing a component moves the entity to another table; destroying it moves the last row of its
+// table into the hole, so tables stay dense. Components are copied bytewise and must be trivially copyable.
+// The registry is not thread safe, but each() may spread a query over the job system, as long as the systems
+// only change the components they are handed (never create, destroy, add or remove while iterating).
+
+struct Entity
+{
+    static constexpr std::uint32_t INVALID = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID;
+    std::uint32_t generation = 0; // Bumped when the index is reused, so stale handles stop resolving
+
+    bool operator==(const Entity &o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const Entity &o) const { return !(*this == o); }
+};
+
+using ComponentMask = std::uint64_t; // Bit per component id
+constexpr int MAX_COMPONENTS = 64;
+
+namespace ecs_detail
+{
+    // Masks have one bit per component type, so a program may use at most MAX_COMPONENTS of them; one more is a
+    // bug that would corrupt every mask and table, so it stops the program right away
+    inline int nextComponentId()
+    {
+        static std::atomic<int> next{0};
+        int id = next++;
+        if (id >= MAX_COMPONENTS)
+        {
+            std::fprintf(stderr, "EntityRegistry: more than %d component types\n", MAX_COMPONENTS);
+            std::abort();
+        }
+        return id;
+    }
+
+    // Ids are handed out on first use, in whatever order the component types are first seen
+    template <typename T>
+    int componentId()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "components are copied bytewise");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "columns are only aligned to std::max_align_t");
+        static const int id = nextComponentId();
+        return id;
+    }
+
+    template <typename... Components>
+    ComponentMask maskOf()
+    {
+        return (ComponentMask(0) | ... | (ComponentMask(1) << componentId<Components>()));
+    }
+}
+
+class EntityRegistry
+{
+public:
+    // New entity with the given components
+    template <typename... Components>
+    Entity create(const Components &...components)
+    {
+        (registerComponent<Components>(), ...);
+        Entity entity = allocate(archetypeFor(ecs_detail::maskOf<Components...>()));
+        (std::memcpy(rowOf(entity, ecs_detail::componentId<Components>()), &components, sizeof(Components)), ...);
+        return entity;
+    }
+
+    // Stale or already destroyed entities are ignored
+    void destroy(Entity entity);
+    bool alive(Entity entity) const
+    {
+        return entity.index < m_slots.size() && m_slots[entity.index].generation == entity.generation &&
+               m_slots[entity.index].archetype != NO_ARCHETYPE;
+    }
+
+    // nullptr if the entity is gone or does not have the component. Only valid until the next structural change.
+    template <typename T>
+    T *get(Entity entity)
+    {
+        return alive(entity) ? static_cast<T *>(rowOf(entity, ecs_detail::componentId<T>())) : nullptr;
+    }
+
+    // Adds the component, or overwrites it if the entity has it already
+    template <typename T>
+    void add(Entity entity, const T &component)
+    {
+        if (!alive(entity))
+            return;
+        registerComponent<T>();
+        int id = ecs_detail::componentId<T>();
+        ComponentMask mask = m_archetypes[m_slots[entity.index].archetype].mask;
+        if (!(mask & (ComponentMask(1) << id)))
+            moveTo(entity, archetypeFor(mask | (ComponentMask(1) << id)));
+        std::memcpy(rowOf(entity, id), &component, sizeof(T));
+    }
+
+    template <typename T>
+    void remove(Entity entity)
+    {
+        if (!alive(entity))
+            return;
+        ComponentMask bit = ComponentMask(1) << ecs_detail::componentId<T>();
+        ComponentMask mask = m_archetypes[m_slots[entity.index].archetype].mask;
+        if (mask & bit)
+            moveTo(entity, archetypeFor(mask & ~bit));
+    }
+
+    // Calls system(entity, components...) for every entity that has all of the components (and maybe others)
+    template <typename... Components, typename System>
+    void each(System &&system)
+    {
+        ComponentMask required = ecs_detail::maskOf<Components...>();
+        for (Archetype &archetype : m_archetypes)
+            if ((archetype.mask & required) == required && !archetype.entities.empty())
+                runRows(archetype, 0, archetype.entities.size(), system, archetype.template column<Components>()...);
+    }
+
+    // Same, with every table split into ranges of grainSize rows that run on the job system's workers
+    template <typename... Components, typename System>
+    void each(JobSystem &jobs, std::size_t grainSize, System &&system)
+    {
+        ComponentMask required = ecs_detail::maskOf<Components...>();
+        for (Archetype &archetype : m_archetypes)
+        {
+            if ((archetype.mask & required) != required || archetype.entities.empty())
+                continue;
+            auto columns = std::make_tuple(archetype.template column<Components>()...);
+            jobs.parallelFor(0, archetype.entities.size(), grainSize, [&](std::size_t first, std::size_t last)
+            {
+                std::apply([&](auto *...arrays) { runRows(archetype, first, last, system, arrays...); }, columns);
+            });
+        }
+    }
+
+    std::size_t count() const { return m_count; }
+    std::size_t archetypeCount() const { return m_archetypes.size(); }
+    std::size_t memoryUsage() const;
+
+private:
+    static constexpr std::uint32_t NO_ARCHETYPE = 0xFFFFFFFFu;
+
+    struct Column
+    {
+        std::size_t elementSize = 0;
+        std::vector<unsigned char> data; // elementSize bytes per row; new[] aligns it for any component
+    };
+
+    struct Archetype
+    {
+        ComponentMask mask = 0;
+        std::vector<Entity> entities;         // Entity of every row
+        std::vector<Column> columns;          // In component id order
+        std::int8_t columnOf[MAX_COMPONENTS]; // Column of each component id, -1 if the table does not have it
+
+        template <typename T>
+        T *column()
+        {
+            return reinterpret_cast<T *>(columns[std::size_t(columnOf[ecs_detail::componentId<T>()])].data.data());
+        }
+    };
+
+    struct Slot
+    {
+        std::uint32_t archetype = NO_ARCHETYPE;
+        std::uint32_t row = 0;
+        std::uint32_t generation = 0;
+    };
+
+    template <typename System, typename... Arrays>
+    static void runRows(Archetype &archetype, std::size_t first, std::size_t last, System &system, Arrays *...arrays)
+    {
+        const Entity *entities = archetype.entities.data();
+        for (std::size_t row = first; row < last; ++row)
+            system(entities[row], arrays[row]...);
+    }
+
+    template <typename T>
+    void registerComponent()
+    {
+        m_componentSizes[ecs_detail::componentId<T>()] = sizeof(T);
+    }
+
+    std::uint32_t archetypeFor(ComponentMask mask);
+    // Appends a row for a new entity to the table (components zeroed)
+    Entity allocate(std::uint32_t archetype);
+    // Moves the entity's row to another table, keeping the components both have; new ones are zeroed
+    void moveTo(Entity entity, std::uint32_t archetype);
+    // Fills the hole with the table's last row
+    void removeRow(std::uint32_t archetype, std::uint32_t row);
+    void *rowOf(Entity entity, int componentId);
+
+    std::vector<Archetype> m_archetypes;
+    std::unordered_map<ComponentMask, std::uint32_t> m_archetypeByMask;
+    std::size_t m_componentSizes[MAX_COMPONENTS] = {};
+
+    std::vector<Slot> m_slots;                // Indexed by Entity::index
+    std::vector<std::uint32_t> m_freeIndices; // Slots of destroyed entities, reused first
+    std::size_t m_count = 0;
+};
+
+#endif
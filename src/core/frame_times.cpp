@@ -0,0 +1,39 @@
+#include "core/frame_times.h"
+
+#include <algorithm> // For std::sort
+#include <cstdio>    // For std::printf
+
+double percentile(std::vector<double> &samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    std::size_t i = std::size_t(p / 100.0 * double(samples.size() - 1) + 0.5);
+    return samples[std::min(i, samples.size() - 1)];
+}
+
+FrameTimes::Summary FrameTimes::summarize() const
+{
+    Summary summary;
+    if (m_millis.empty())
+        return summary;
+
+    std::vector<double> sorted = m_millis;
+    summary.p50 = percentile(sorted, 50.0); // Sorts, the later calls find it sorted already
+    summary.p90 = percentile(sorted, 90.0);
+    summary.p99 = percentile(sorted, 99.0);
+    summary.max = sorted.back();
+    double sum = 0.0;
+    for (double millis : sorted)
+        sum += millis;
+    summary.mean = sum / double(sorted.size());
+    return summary;
+}
+
+void FrameTimes::print(const char *label) const
+{
+    Summary summary = summarize();
+    std::printf("%s: %zu frames, mean %.3f ms (%.1f fps), p50 %.3f, p90 %.3f, p99 %.3f, max %.3f ms\n", label, m_millis.size(), summary.mean,
+                summary.mean > 0.0 ? 1000.0 / summary.mean : 0.0, summary.p50, summary.p90, summary.p99, summary.max);
+    std::fflush(stdout);
+}
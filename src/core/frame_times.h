@@ -0,0 +1,37 @@
+#ifndef FRAME_TIMES_H
+#define FRAME_TIMES_H
+
+#include <cstddef> // For std::size_t
+#include <vector>  // For the samples
+
+// The sample nearest to p percent of the way through the sorted samples, p in [0, 100]: the linear index
+// p / 100 * (n - 1) is rounded, not interpolated. Sorts the samples in place; 0 when there are none.
+double percentile(std::vector<double> &samples, double p);
+
+// Frame times of a scripted run, summarised as percentiles. The tail (p99, max) is what a player notices as
+// a hitch, so automated runs report it next to the mean instead of a single average.
+class FrameTimes
+{
+public:
+    void reserve(std::size_t frames) { m_millis.reserve(frames); }
+    void add(double millis) { m_millis.push_back(millis); }
+    std::size_t count() const { return m_millis.size(); }
+
+    struct Summary
+    {
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+    Summary summarize() const;
+
+    // One line on stdout, e.g. "render: 600 frames, mean 4.21 ms (237.5 fps), p50 4.10, p90 4.80, p99 6.02, max 9.11 ms"
+    void print(const char *label) const;
+
+private:
+    std::vector<double> m_millis;
+};
+
+#endif
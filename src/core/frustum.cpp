@@ -0,0 +1,120 @@
+#include "core/frustum.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // For SSE2 intrinsics (always available on x86-64)
+#endif
+
+namespace
+{
+    // Per plane the box corner furthest along the normal decides OUTSIDE, the nearest one INSIDE
+    CullResult classifyScalar(const float planes[6][4], float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+    {
+        CullResult result = CullResult::INSIDE;
+        for (int i = 0; i < 6; ++i)
+        {
+            const float *p = planes[i];
+            // Summed in the same order as the SIMD path, so both give identical results
+            float far = p[3] + p[0] * (p[0] > 0.0f ? maxX : minX);
+            far = far + p[1] * (p[1] > 0.0f ? maxY : minY);
+            far = far + p[2] * (p[2] > 0.0f ? maxZ : minZ);
+            if (far < 0.0f)
+                return CullResult::OUTSIDE;
+            float near = p[3] + p[0] * (p[0] > 0.0f ? minX : maxX);
+            near = near + p[1] * (p[1] > 0.0f ? minY : maxY);
+            near = near + p[2] * (p[2] > 0.0f ? minZ : maxZ);
+            if (near < 0.0f)
+                result = CullResult::INTERSECTS;
+        }
+        return result;
+    }
+}
+
+void AabbList::clear()
+{
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+}
+
+void AabbList::push(const Aabb &box)
+{
+    minX.push_back(box.min.x);
+    minY.push_back(box.min.y);
+    minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x);
+    maxY.push_back(box.max.y);
+    maxZ.push_back(box.max.z);
+}
+
+Frustum::Frustum(const Mat4 &viewProjection)
+{
+    // Each plane is the last row plus or minus one of the others: left, right, bottom, top, near, far
+    for (int i = 0; i < 6; ++i)
+    {
+        int row = i / 2;
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        float *p = m_planes[i];
+        for (int column = 0; column < 4; ++column)
+            p[column] = viewProjection.at(3, column) + sign * viewProjection.at(row, column);
+
+        float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (length > 0.0f)
+            for (int column = 0; column < 4; ++column)
+                p[column] /= length;
+    }
+}
+
+CullResult Frustum::classify(const Aabb &box) const
+{
+    return classifyScalar(m_planes, box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z);
+}
+
+void Frustum::classify(const AabbList &boxes, CullResult *out, bool scalar) const
+{
+    std::size_t count = boxes.size();
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    if (!scalar)
+    {
+        // Four boxes against one plane per step. The plane's signs are the same for all four, so picking the
+        // far and near corners is a choice of array, not a per-lane select.
+        for (; i + 4 <= count; i += 4)
+        {
+            const float *low[3] = {&boxes.minX[i], &boxes.minY[i], &boxes.minZ[i]};
+            const float *high[3] = {&boxes.maxX[i], &boxes.maxY[i], &boxes.maxZ[i]};
+            __m128 outside = _mm_setzero_ps();
+            __m128 crossing = _mm_setzero_ps();
+            for (int p = 0; p < 6; ++p)
+            {
+                const float *plane = m_planes[p];
+                __m128 far = _mm_set1_ps(plane[3]);
+                __m128 near = far;
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    __m128 n = _mm_set1_ps(plane[axis]);
+                    bool positive = plane[axis] > 0.0f;
+                    far = _mm_add_ps(far, _mm_mul_ps(n, _mm_loadu_ps(positive ? high[axis] : low[axis])));
+                    near = _mm_add_ps(near, _mm_mul_ps(n, _mm_loadu_ps(positive ? low[axis] : high[axis])));
+                }
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(far, _mm_setzero_ps()));
+                crossing = _mm_or_ps(crossing, _mm_cmplt_ps(near, _mm_setzero_ps()));
+            }
+            int outsideMask = _mm_movemask_ps(outside);
+            int crossingMask = _mm_movemask_ps(crossing);
+            for (int lane = 0; lane < 4; ++lane)
+                out[i + std::size_t(lane)] = (outsideMask >> lane) & 1   ? CullResult::OUTSIDE
+                                             : (crossingMask >> lane) & 1 ? CullResult::INTERSECTS
+                                                                          : CullResult::INSIDE;
+        }
+    }
+#else
+    (void)scalar;
+#endif
+
+    for (; i < count; ++i)
+        out[i] = classifyScalar(m_planes, boxes.minX[i], boxes.minY[i], boxes.minZ[i], boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+}
@@ -0,0 +1,52 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For std::uint8_t
+#include <vector>  // For the box lists
+
+#include "core/vecmath.h"
+
+struct Aabb
+{
+    Vec3 min;
+    Vec3 max;
+};
+
+enum class CullResult : std::uint8_t
+{
+    OUTSIDE,    // Entirely behind at least one plane
+    INTERSECTS, // Crosses a plane (or is too close to tell), draw it
+    INSIDE,     // Entirely inside, so is everything it contains
+};
+
+// Boxes stored as structure of arrays, so the batch test loads four of them per SIMD register
+struct AabbList
+{
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    void clear();
+    void push(const Aabb &box);
+    std::size_t size() const { return minX.size(); }
+};
+
+// The six planes of a view-projection matrix (Gribb-Hartmann extraction), normals pointing inwards.
+// Box tests are conservative: a box is only OUTSIDE if it lies behind a single plane, so a few boxes near
+// the frustum corners are reported as INTERSECTS although nothing of them is visible.
+class Frustum
+{
+public:
+    Frustum() = default;
+    explicit Frustum(const Mat4 &viewProjection);
+
+    CullResult classify(const Aabb &box) const;
+
+    // Classifies every box in the list, four at a time with SSE (scalar elsewhere, same results); out needs
+    // boxes.size() entries. Scalar forces the scalar path, for comparisons.
+    void classify(const AabbList &boxes, CullResult *out, bool scalar = false) const;
+
+private:
+    float m_planes[6][4] = {}; // (nx, ny, nz, d): inside where dot(n, p) + d >= 0
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "core/job_system.h"
+
+#include <algorithm> // For std::min
+
+namespace
+{
+    // Which job system (if any) the current thread works for, and its worker index there
+    struct WorkerIdentity
+    {
+        const JobSystem *system = nullptr;
+        int index = -1;
+    };
+    thread_local WorkerIdentity t_worker;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    if (workerCount == 0)
+    {
+        unsigned hardwareThreads = std::thread::hardware_concurrency(); // May be 0 if unknown
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_workers.emplace_back([this, i] { workerLoop(int(i)); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &worker : m_workers)
+        worker.join();
+}
+
+int JobSystem::currentWorker() const
+{
+    return t_worker.system == this ? t_worker.index : -1;
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work, std::initializer_list<JobHandle> dependencies)
+{
+    return schedule(std::move(work), std::vector<JobHandle>(dependencies));
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work, const std::vector<JobHandle> &dependencies)
+{
+    JobHandle job = std::make_shared<Job>();
+    job->work = std::move(work);
+
+    // Hold one extra count while registering so a dependency finishing meanwhile cannot queue the job early
+    job->pendingDependencies.store(1, std::memory_order_relaxed);
+    for (const JobHandle &dependency : dependencies)
+    {
+        if (!dependency)
+            continue;
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (dependency->finished.load(std::memory_order_acquire))
+            continue;
+        job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        dependency->continuations.push_back(job);
+    }
+
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        enqueue(job);
+    return job;
+}
+
+void JobSystem::enqueue(JobHandle job)
+{
+    int worker = currentWorker();
+    WorkerQueue &queue = worker >= 0 ? *m_queues[worker] : m_injection;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    m_queuedJobs.fetch_add(1);
+    // Either a parking worker sees the new count, or we see it registered as a sleeper and wake it.
+    // Taking the sleep lock makes sure it is really waiting before we notify.
+    if (m_sleepers.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+}
+
+void JobSystem::finish(const JobHandle &job)
+{
+    job->work = nullptr; // Release captured state now, handles may outlive the job by a lot
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->continuationMutex);
+        job->finished.store(true, std::memory_order_release);
+        ready.swap(job->continuations);
+    }
+
+    for (JobHandle &continuation : ready)
+        if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            enqueue(std::move(continuation));
+}
+
+JobHandle JobSystem::findJob(int workerIndex)
+{
+    JobHandle job;
+
+    // Own deque first, newest job first (its data is most likely still in cache)
+    if (workerIndex >= 0)
+    {
+        WorkerQueue &own = *m_queues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+
+    if (!job)
+    {
+        std::lock_guard<std::mutex> lock(m_injection.mutex);
+        if (!m_injection.jobs.empty())
+        {
+            job = std::move(m_injection.jobs.front());
+            m_injection.jobs.pop_front();
+        }
+    }
+
+    // Steal the oldest job of another worker
+    std::size_t count = m_queues.size();
+    for (std::size_t i = 1; !job && i <= count; ++i)
+    {
+        WorkerQueue &victim = *m_queues[(std::size_t(workerIndex + 1) + i - 1) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (job)
+        m_queuedJobs.fetch_sub(1);
+    return job;
+}
+
+bool JobSystem::tryRunOne(int workerIndex)
+{
+    JobHandle job = findJob(workerIndex);
+    if (!job)
+        return false;
+
+    job->work();
+    finish(job);
+    return true;
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    t_worker = {this, workerIndex};
+
+    for (;;)
+    {
+        if (tryRunOne(workerIndex))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wake.wait(lock, [this] { return m_stopping || m_queuedJobs.load() > 0; });
+        m_sleepers.fetch_sub(1);
+        if (m_stopping && m_queuedJobs.load() == 0)
+            return;
+    }
+}
+
+void JobSystem::wait(const JobHandle &job)
+{
+    if (!job)
+        return;
+
+    // Help out instead of blocking, which also makes waiting from inside a job safe
+    int worker = currentWorker();
+    while (!job->finished.load(std::memory_order_acquire))
+    {
+        if (!tryRunOne(worker))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle> &jobs)
+{
+    for (const JobHandle &job : jobs)
+        wait(job);
+}
+
+void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                            const std::function<void(std::size_t first, std::size_t last)> &body)
+{
+    if (begin >= end)
+        return;
+    grainSize = std::max<std::size_t>(grainSize, 1);
+
+    std::vector<JobHandle> jobs;
+    jobs.reserve((end - begin + grainSize - 1) / grainSize);
+    for (std::size_t first = begin; first < end; first += grainSize)
+    {
+        std::size_t last = std::min(first + grainSize, end);
+        jobs.push_back(schedule([&body, first, last] { body(first, last); }));
+    }
+    waitAll(jobs);
+}
@@ -0,0 +1,84 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>             // For job counters and flags
+#include <condition_variable> // For parking idle workers
+#include <cstddef>            // For std::size_t
+#include <deque>              // For the per-worker job deques
+#include <functional>         // For std::function
+#include <initializer_list>   // For dependency lists
+#include <memory>             // For std::shared_ptr job handles
+#include <mutex>              // For the deque locks
+#include <thread>             // For the worker threads
+#include <vector>             // For workers and continuations
+
+// One unit of work. Held through a JobHandle so callers can wait on it or use it as a dependency.
+struct Job
+{
+    std::function<void()> work;
+    std::atomic<int> pendingDependencies{0}; // Queued once this reaches zero
+    std::atomic<bool> finished{false};
+
+    std::mutex continuationMutex;
+    std::vector<std::shared_ptr<Job>> continuations; // Jobs waiting for this one
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+// Work-stealing job scheduler shared by the whole engine (meshing, world generation, saving, ...).
+// Every worker owns a deque: it pushes and pops at the back (newest first, cache friendly) while
+// idle workers steal from the front of other deques. Jobs scheduled from non-worker threads go into
+// a shared injection queue.
+class JobSystem
+{
+public:
+    // workerCount 0 picks one worker per hardware thread, leaving one for the main thread
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // Runs work once every dependency has finished (dependencies may be null or already done)
+    JobHandle schedule(std::function<void()> work, std::initializer_list<JobHandle> dependencies = {});
+    JobHandle schedule(std::function<void()> work, const std::vector<JobHandle> &dependencies);
+
+    // Blocks until the job finished, running other jobs on the calling thread in the meantime
+    void wait(const JobHandle &job);
+    void waitAll(const std::vector<JobHandle> &jobs);
+
+    // Calls body(first, last) over [begin, end) split into ranges of at most grainSize, and waits.
+    // Typical use is one index per chunk or per section.
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                     const std::function<void(std::size_t first, std::size_t last)> &body);
+
+    unsigned workerCount() const { return unsigned(m_workers.size()); }
+
+    // Index of the calling worker thread, or -1 for threads that do not belong to this job system
+    int currentWorker() const;
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    void enqueue(JobHandle job);
+    void finish(const JobHandle &job);
+    bool tryRunOne(int workerIndex);
+    JobHandle findJob(int workerIndex);
+    void workerLoop(int workerIndex);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    WorkerQueue m_injection; // Jobs scheduled from outside the workers
+    std::vector<std::thread> m_workers;
+
+    std::atomic<int> m_queuedJobs{0}; // Jobs sitting in any queue, workers sleep while this is zero
+    std::atomic<int> m_sleepers{0};   // Workers parked on m_wake
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_stopping{false};
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>  // For the lock-free links
+#include <utility> // For std::move
+
+// Unbounded lock-free multi-producer / single-consumer queue (Dmitry Vyukov's intrusive design).
+// push() is wait-free and may be called from any thread; tryPop() must only be called by one thread.
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+    {
+        Node *stub = new Node();
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    ~MpscQueue()
+    {
+        T ignored;
+        while (tryPop(ignored))
+        {
+        }
+        delete m_tail;
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void push(T value)
+    {
+        Node *node = new Node();
+        node->value = std::move(value);
+        // Swing the head to the new node, then link the previous head to it.
+        // Between the two steps the consumer simply sees the queue as shorter.
+        Node *previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool tryPop(T &out)
+    {
+        Node *tail = m_tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+
+        // `next` becomes the new stub; its value is moved out and the old stub freed
+        out = std::move(next->value);
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node *> m_head; // Producers push here
+    Node *m_tail;               // Consumer-only end, always points at the current stub node
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "core/range_allocator.h"
+
+#include <iterator> // For std::prev, std::next
+
+RangeAllocator::RangeAllocator(std::uint32_t capacity)
+{
+    grow(capacity);
+}
+
+void RangeAllocator::insertFree(std::uint32_t offset, std::uint32_t size)
+{
+    m_free.emplace(offset, size);
+    m_bySize.emplace(size, offset);
+}
+
+void RangeAllocator::eraseFree(std::map<std::uint32_t, std::uint32_t>::iterator it)
+{
+    m_bySize.erase({it->second, it->first});
+    m_free.erase(it);
+}
+
+std::uint32_t RangeAllocator::take(std::set<std::pair<std::uint32_t, std::uint32_t>>::iterator it, std::uint32_t size)
+{
+    // Take the front of the free range, the rest stays free
+    auto [freeSize, offset] = *it;
+    eraseFree(m_free.find(offset));
+    if (freeSize > size)
+        insertFree(offset + size, freeSize - size);
+    m_used += size;
+    return offset;
+}
+
+std::uint32_t RangeAllocator::allocate(std::uint32_t size)
+{
+    if (size == 0)
+        return INVALID;
+    auto it = m_bySize.lower_bound({size, 0});
+    return it == m_bySize.end() ? INVALID : take(it, size);
+}
+
+std::uint32_t RangeAllocator::allocateBelow(std::uint32_t size, std::uint32_t limit)
+{
+    if (size == 0)
+        return INVALID;
+    for (auto it = m_bySize.lower_bound({size, 0}); it != m_bySize.end(); ++it)
+        if (it->second + size <= limit)
+            return take(it, size);
+    return INVALID;
+}
+
+void RangeAllocator::free(std::uint32_t offset, std::uint32_t size)
+{
+    if (offset == INVALID || size == 0)
+        return;
+    m_used -= size;
+
+    auto next = m_free.lower_bound(offset);
+    if (next != m_free.end() && offset + size == next->first)
+    {
+        size += next->second;
+        auto after = std::next(next);
+        eraseFree(next);
+        next = after;
+    }
+    if (next != m_free.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            size += previous->second;
+            eraseFree(previous);
+        }
+    }
+    insertFree(offset, size);
+}
+
+void RangeAllocator::grow(std::uint32_t capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+    std::uint32_t added = capacity - m_capacity;
+    std::uint32_t offset = m_capacity;
+    m_capacity = capacity;
+    m_used += added; // free() takes it off again
+    free(offset, added);
+}
+
+float RangeAllocator::fragmentation() const
+{
+    std::uint32_t freeSpace = m_capacity - m_used;
+    return freeSpace == 0 ? 0.0f : 1.0f - float(largestFreeRange()) / float(freeSpace);
+}
@@ -0,0 +1,50 @@
+#ifndef RANGE_ALLOCATOR_H
+#define RANGE_ALLOCATOR_H
+
+#include <cstdint> // For range offsets and sizes
+#include <map>     // For the free list, ordered by offset
+#include <set>     // For the free list, ordered by size
+#include <utility> // For std::pair
+
+// Hands out ranges of [0, capacity) in whatever unit the caller uses (vertices, indices), best fit.
+// Only the bookkeeping: it never touches memory, so it can manage a GPU buffer from the CPU side.
+// Freed ranges merge with free neighbours, so the free list never holds two adjacent ranges.
+class RangeAllocator
+{
+public:
+    static constexpr std::uint32_t INVALID = ~0u;
+
+    explicit RangeAllocator(std::uint32_t capacity = 0);
+
+    // Offset of a new range of size units taken from the smallest free range that fits (the lowest one
+    // among equals), or INVALID if none is big enough
+    std::uint32_t allocate(std::uint32_t size);
+    // Like allocate, but only from free space entirely below limit; used to move ranges down when compacting
+    std::uint32_t allocateBelow(std::uint32_t size, std::uint32_t limit);
+    // Size must be the one given to allocate
+    void free(std::uint32_t offset, std::uint32_t size);
+
+    // Adds free space at the end; capacity can only grow
+    void grow(std::uint32_t capacity);
+
+    std::uint32_t capacity() const { return m_capacity; }
+    std::uint32_t used() const { return m_used; }
+    std::uint32_t freeRangeCount() const { return std::uint32_t(m_free.size()); }
+    std::uint32_t largestFreeRange() const { return m_bySize.empty() ? 0 : m_bySize.rbegin()->first; }
+
+    // 0 when all free space is one range, towards 1 the more it is split into small pieces:
+    // 1 - largest free range / total free space
+    float fragmentation() const;
+
+private:
+    void insertFree(std::uint32_t offset, std::uint32_t size);
+    void eraseFree(std::map<std::uint32_t, std::uint32_t>::iterator it);
+    std::uint32_t take(std::set<std::pair<std::uint32_t, std::uint32_t>>::iterator it, std::uint32_t size);
+
+    std::map<std::uint32_t, std::uint32_t> m_free;              // Offset -> size
+    std::set<std::pair<std::uint32_t, std::uint32_t>> m_bySize; // (size, offset), the same ranges
+    std::uint32_t m_capacity = 0;
+    std::uint32_t m_used = 0;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "core/simulation_loop.h"
+
+#include <algorithm> // For std::max
+#include <utility>   // For std::move
+
+SimulationLoop::SimulationLoop(double ticksPerSecond, TickFunction tick, int maxCatchUp)
+    : m_tickSeconds(1.0 / ticksPerSecond), m_tick(std::move(tick)), m_maxCatchUp(maxCatchUp), m_start(std::chrono::steady_clock::now())
+{
+}
+
+double SimulationLoop::now() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+double SimulationLoop::runDueTicks()
+{
+    double time = now();
+    std::uint64_t due = std::uint64_t(time / m_tickSeconds); // Ticks whose end lies in the past
+    if (due > m_nextTick + std::uint64_t(m_maxCatchUp))
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats.droppedTicks += due - std::uint64_t(m_maxCatchUp) - m_nextTick;
+        m_nextTick = due - std::uint64_t(m_maxCatchUp);
+    }
+
+    for (; m_nextTick < due; ++m_nextTick)
+    {
+        auto start = std::chrono::steady_clock::now();
+        m_tick(m_nextTick, m_tickSeconds);
+        double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.ticks;
+        ++m_ticksSinceStats;
+        m_tickMillisSum += millis;
+        m_stats.maxTickMillis = std::max(m_stats.maxTickMillis, millis);
+    }
+    return tickTime(m_nextTick);
+}
+
+void SimulationLoop::pump()
+{
+    if (!threaded())
+        runDueTicks();
+}
+
+void SimulationLoop::start()
+{
+    if (threaded())
+        return;
+    m_running = true;
+    m_thread = std::thread([this]
+    {
+        while (m_running)
+        {
+            double next = runDueTicks();
+            // Sleep until the next tick is due; sleep_until may wake early, the loop just checks again
+            std::this_thread::sleep_until(m_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                        std::chrono::duration<double>(next)));
+        }
+    });
+}
+
+void SimulationLoop::stop()
+{
+    if (!threaded())
+        return;
+    m_running = false;
+    m_thread.join();
+}
+
+SimulationLoop::Stats SimulationLoop::stats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    Stats stats = m_stats;
+    stats.averageTickMillis = m_ticksSinceStats ? m_tickMillisSum / double(m_ticksSinceStats) : 0.0;
+    m_tickMillisSum = 0.0;
+    m_ticksSinceStats = 0;
+    m_stats.maxTickMillis = 0.0;
+    return stats;
+}
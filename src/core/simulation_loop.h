@@ -0,0 +1,109 @@
+#ifndef SIMULATION_LOOP_H
+#define SIMULATION_LOOP_H
+
+#include <atomic>     // For the stop flag
+#include <chrono>     // For the simulation clock
+#include <cstdint>    // For tick numbers
+#include <functional> // For std::function
+#include <mutex>      // For the stats and the state snapshots
+#include <thread>     // For the optional simulation thread
+
+// Game logic at a fixed rate, independent of how fast frames are rendered. Tick k simulates the step that
+// ends at time (k + 1) * tickSeconds on the loop's clock, whatever the frame rate, so the simulation behaves
+// the same at 30 and at 300 fps.
+//
+// Either the render loop calls pump() once per frame, which runs every tick that came due since (a fixed
+// step accumulator), or start() moves the ticks to a thread of their own that sleeps until the next one is
+// due, so a slow frame no longer delays the simulation. The tick function must then only touch state it
+// owns and publish what the renderer needs through TickSnapshots.
+//
+// When ticks fall more than maxCatchUp behind (a breakpoint, a hitch), the backlog is dropped instead of
+// simulated in a burst that would only fall further behind.
+class SimulationLoop
+{
+public:
+    // Called with the tick number and its fixed duration in seconds
+    using TickFunction = std::function<void(std::uint64_t tick, double seconds)>;
+
+    SimulationLoop(double ticksPerSecond, TickFunction tick, int maxCatchUp = 5);
+    ~SimulationLoop() { stop(); }
+
+    SimulationLoop(const SimulationLoop &) = delete;
+    SimulationLoop &operator=(const SimulationLoop &) = delete;
+
+    // Same-thread mode: runs the ticks that are due now
+    void pump();
+
+    // Threaded mode: runs the ticks on their own thread until stop()
+    void start();
+    void stop();
+    bool threaded() const { return m_thread.joinable(); }
+
+    // Seconds on the simulation clock, which starts at construction
+    double now() const;
+    double tickSeconds() const { return m_tickSeconds; }
+    // Time at which tick k ends, the time its state belongs to
+    double tickTime(std::uint64_t tick) const { return double(tick + 1) * m_tickSeconds; }
+
+    struct Stats
+    {
+        std::uint64_t ticks = 0;
+        std::uint64_t droppedTicks = 0; // Skipped because the simulation fell too far behind
+        double averageTickMillis = 0.0; // Over the ticks since the previous stats() call
+        double maxTickMillis = 0.0;
+    };
+    // Also restarts the average and maximum
+    Stats stats();
+
+private:
+    // Runs the due ticks; returns when the next one is due
+    double runDueTicks();
+
+    double m_tickSeconds;
+    TickFunction m_tick;
+    int m_maxCatchUp;
+    std::chrono::steady_clock::time_point m_start;
+    std::uint64_t m_nextTick = 0;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_statsMutex;
+    Stats m_stats;
+    double m_tickMillisSum = 0.0;
+    std::uint64_t m_ticksSinceStats = 0;
+};
+
+// The two newest states of the simulation, written by the tick and read by the renderer, which draws a
+// blend of them: render time runs one tick behind, so there is always a state on each side of it.
+template <typename State>
+class TickSnapshots
+{
+public:
+    // Called at the end of a tick with the state at time (the tick's end)
+    void publish(const State &state, double time)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_previous = m_current;
+        m_current = state;
+        m_time = time;
+    }
+
+    // The states before and after the render time, and how far (0..1) it lies between them
+    void read(double now, double tickSeconds, State &previous, State &current, float &alpha) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        previous = m_previous;
+        current = m_current;
+        double t = (now - m_time) / tickSeconds;
+        alpha = float(t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t);
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    State m_previous{};
+    State m_current{};
+    double m_time = 0.0;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef VECMATH_H
+#define VECMATH_H
+
+#include <cmath> // For std::sin, std::cos, std::tan, std::sqrt
+
+// Small vector/matrix helpers used by the camera and the world code.
+// Matrices are column-major so they can be handed to glUniformMatrix4fv without transposing.
+
+struct Vec3
+{
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+
+    constexpr Vec3() = default;
+    constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+    constexpr Vec3 operator+(const Vec3 &o) const { return {x + o.x, y + o.y, z + o.z}; }
+    constexpr Vec3 operator-(const Vec3 &o) const { return {x - o.x, y - o.y, z - o.z}; }
+    constexpr Vec3 operator*(float s) const { return {x * s, y * s, z * s}; }
+    Vec3 &operator+=(const Vec3 &o)
+    {
+        x += o.x;
+        y += o.y;
+        z += o.z;
+        return *this;
+    }
+    Vec3 &operator-=(const Vec3 &o)
+    {
+        x -= o.x;
+        y -= o.y;
+        z -= o.z;
+        return *this;
+    }
+    Vec3 &operator*=(float s)
+    {
+        x *= s;
+        y *= s;
+        z *= s;
+        return *this;
+    }
+};
+
+struct IVec3
+{
+    int x = 0, y = 0, z = 0;
+
+    constexpr bool operator==(const IVec3 &o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+inline float dot(const Vec3 &a, const Vec3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(const Vec3 &a, const Vec3 &b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+inline float length(const Vec3 &v) { return std::sqrt(dot(v, v)); }
+inline Vec3 normalize(const Vec3 &v)
+{
+    float len = length(v);
+    return len > 0.0f ? v * (1.0f / len) : v;
+}
+inline Vec3 lerp(const Vec3 &a, const Vec3 &b, float t) { return a + (b - a) * t; }
+
+struct Mat4
+{
+    float m[16] = {}; // column-major: m[column * 4 + row]
+
+    static Mat4 identity()
+    {
+        Mat4 r;
+        r.m[0] = r.m[5] = r.m[10] = r.m[15] = 1.0f;
+        return r;
+    }
+
+    float &at(int row, int column) { return m[column * 4 + row]; }
+    float at(int row, int column) const { return m[column * 4 + row]; }
+
+    const float *data() const { return m; }
+
+    Mat4 operator*(const Mat4 &o) const
+    {
+        Mat4 r;
+        for (int c = 0; c < 4; ++c)
+            for (int row = 0; row < 4; ++row)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k)
+                    sum += at(row, k) * o.at(k, c);
+                r.at(row, c) = sum;
+            }
+        return r;
+    }
+};
+
+// Right-handed perspective projection mapping depth to [-1, 1] (OpenGL convention)
+inline Mat4 perspective(float fovYRadians, float aspect, float zNear, float zFar)
+{
+    float f = 1.0f / std::tan(fovYRadians * 0.5f);
+    Mat4 r;
+    r.at(0, 0) = f / aspect;
+    r.at(1, 1) = f;
+    r.at(2, 2) = (zFar + zNear) / (zNear - zFar);
+    r.at(2, 3) = (2.0f * zFar * zNear) / (zNear - zFar);
+    r.at(3, 2) = -1.0f;
+    return r;
+}
+
+// Right-handed view matrix looking from eye towards center
+inline Mat4 lookAt(const Vec3 &eye, const Vec3 &center, const Vec3 &up)
+{
+    Vec3 f = normalize(center - eye);
+    Vec3 s = normalize(cross(f, up));
+    Vec3 u = cross(s, f);
+
+    Mat4 r = Mat4::identity();
+    r.at(0, 0) = s.x;
+    r.at(0, 1) = s.y;
+    r.at(0, 2) = s.z;
+    r.at(1, 0) = u.x;
+    r.at(1, 1) = u.y;
+    r.at(1, 2) = u.z;
+    r.at(2, 0) = -f.x;
+    r.at(2, 1) = -f.y;
+    r.at(2, 2) = -f.z;
+    r.at(0, 3) = -dot(s, eye);
+    r.at(1, 3) = -dot(u, eye);
+    r.at(2, 3) = dot(f, eye);
+    return r;
+}
+
+// Floor division for negative world coordinates (e.g. block -1 lives in chunk -1, not chunk 0)
+inline int floorDiv(int a, int b)
+{
+    int q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+inline int floorMod(int a, int b)
+{
+    int r = a % b;
+    return (r != 0 && ((r < 0) != (b < 0))) ? r + b : r;
+}
+
+#endif
@@ -1,11 +1,38 @@
 #include <glad/glad.h>  // For OpenGL functions
 #include <GLFW/glfw3.h> // For GLFW functions (e.g., GLFWwindow, glfwCreateWindow) which help with window creation
+#include <algorithm>    // For std::max, std::clamp
+#include <chrono>       // For timing the --no-render run, which has no GLFW clock
 #include <cmath>        // For math functions
+#include <cstdio>       // For std::snprintf, used to format the frame time
+#include <cstdlib>      // For std::atoi, used to parse the command line
+#include <cstring>      // For std::strcmp, used to parse the command line
 #include <iostream>     // For console output
+#include <memory>       // For std::unique_ptr
+#include <mutex>        // For std::mutex, guarding what frames and ticks share
+#include <string>       // For std::string, used to build the window title
+#include <thread>       // For std::this_thread::yield while waiting for meshes
 #include <vector>       // For std::vector, a dynamic array (for storing vertices, colors, etc.) which help with dynamic memory allocation
 
 #include "shader.h"    // Include the Shader class for handling shaders
-#include "stb_image.h" // Include stb_image for image loading
+
+#include "core/camera.h"               // Camera with view/projection matrices
+#include "core/frame_times.h"          // Frame time percentiles of --headless and --no-render runs
+#include "core/frustum.h"              // View frustum for culling chunk sections
+#include "core/job_system.h"           // Work-stealing job scheduler
+#include "core/simulation_loop.h"      // Fixed-timestep game logic, optionally on its own thread
+#include "render/block_textures.h"     // Block textures as a 2D texture array
+#include "render/chunk_renderer.h"     // Uploads and draws chunk meshes
+#include "render/offscreen_target.h"   // Framebuffer object for --headless runs
+#include "render/program_cache.h"      // On-disk cache of linked shader programs
+#include "storage/chunk_saver.h"       // Saves chunks on a background thread
+#include "texture/baked_texture.h"     // Build-time baked block textures
+#include "texture/texture_loader.h"    // Builds the block texture layers in the background
+#include "world/entities.h"            // Mobs, dropped items and projectiles
+#include "world/light_engine.h"        // Sky and block light flood fill
+#include "world/terrain_generator.h"   // Procedural terrain
+#include "world/voxel_physics.h"       // Player collision with the terrain
+#include "world/voxel_raycast.h"       // Block picking under the mouse cursor
+#include "world/world.h"               // Chunked voxel world storage
 
 // Window dimensions
 const int WIDTH = 1368;
@@ -16,17 +43,106 @@ const float RADIUS = 0.5f;
 const int NUM_SEGMENTS = 100;
 const float PI = 3.14159265359f;
 
-void framebuffer_size_callback(GLFWwindow *window, int width, int height); // Callback function for window resize
-void processInput(GLFWwindow *window);                                     // Callback function for keyboard input
+// Number of chunks loaded in every direction around the origin
+const int WORLD_RADIUS = 4;
+const std::uint64_t WORLD_SEED = 1337;
+
+// Where the world is saved (relative to the build directory, like the textures) and how often
+const char *const SAVE_DIRECTORY = "../saves/world";
+const double AUTOSAVE_SECONDS = 30.0;
+const char *const SHADER_CACHE_DIRECTORY = "../shader_cache"; // Linked program binaries
+
+// Frames of a --headless or --no-render run when no count is given
+const int DEFAULT_SCRIPTED_FRAMES = 600;
+const int NO_RENDER_EDITS_PER_FRAME = 8; // Blocks flipped per --no-render frame, so there is always something to mesh
+
+// Game logic runs at a fixed rate, whatever the frame rate; frames draw a blend of the two newest ticks
+const double SIMULATION_RATE = 30.0; // Ticks per second
+
+// Block picking
+const float PICK_REACH = 160.0f; // Far enough to reach the terrain from the orbiting camera
+
+// Walking on the terrain (F toggles it; WASD, space to jump, arrow keys to look around)
+const float WALK_SPEED = 4.3f; // Blocks per second
+const float JUMP_SPEED = 9.0f; // Blocks per second upwards, a bit more than one block high
+const float EYE_HEIGHT = 1.6f; // Above the player's feet
+const float TURN_SPEED = 2.0f; // Radians per second
+
+// Entities
+const int MOB_GRID = 10;              // MOB_GRID x MOB_GRID mobs spread over the world at startup
+const float PROJECTILE_SPEED = 40.0f; // Blocks per second, shot with E along the view
+
+// Block textures: the packed atlas is only the decoded, cached form; each tile becomes one texture array layer
+const char *const TEXTURE_CACHE_DIRECTORY = "../texture_cache"; // Packed atlases
+const int TEXTURE_LAYER_SIZE = 256;                             // Power of two, so every mip level halves exactly
+const char *const BAKED_TEXTURE_PATH = "baked/block_textures.sctx"; // Written by the bake_textures build target
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);                            // Callback function for window resize
+void processInput(GLFWwindow *window);                                                                // Callback function for keyboard input
+void loadWorld(World &world, LightEngine &light, JobSystem &jobs, RegionStorage &storage, int radius); // Loads or generates and lights the chunks around the origin
+void saveModifiedChunks(World &world, ChunkSaver &saver);                                             // Queues every chunk with unsaved edits
+
+// What a simulation tick hands to the renderer
+struct CameraState
+{
+    Vec3 position;
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+};
+
+// What a frame hands to the simulation ticks: the keys held while walking
+struct PlayerInput
+{
+    bool walking = false;
+    float forward = 0.0f; // -1..1, backwards to forwards
+    float strafe = 0.0f;  // -1..1, left to right
+    float turn = 0.0f;    // -1..1, left to right
+    float look = 0.0f;    // -1..1, down to up
+    bool jump = false;
+};
+
+// Command line options
+struct Options
+{
+    bool simulationThread = false; // --sim-thread: simulation ticks on their own thread instead of between frames
+    int headlessFrames = 0;        // --headless [frames]: render a scripted camera path offscreen, print frame times, exit
+    int noRenderFrames = 0;        // --no-render [frames]: only world edits and meshing, no window or GL (CPU profiling)
+};
+
+bool parseOptions(int argc, char **argv, Options &options);     // False (after printing the usage) on anything unknown
+CameraState scriptedCameraState(int frame, int frames);         // Camera path of --headless runs
+int runWithoutRendering(const Options &options);                // The --no-render mode
+std::size_t submitDirtySections(World &world, MeshingPool &pool); // Snapshots and queues every dirty section, returns how many
 
-int main()
+int main(int argc, char **argv)
 {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return -1;
+    if (options.noRenderFrames > 0)
+        return runWithoutRendering(options);
+    bool headless = options.headlessFrames > 0;
+
     // Initialize GLFW
-    if (!glfwInit())
+    bool glfwReady = glfwInit();
+#ifdef GLFW_PLATFORM_NULL
+    // No display at all (a CI box): GLFW 3.4's null platform still creates an OSMesa context (Mesa llvmpipe)
+    bool surfaceless = false;
+    if (!glfwReady && headless)
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        glfwReady = surfaceless = glfwInit();
+    }
+#endif
+    if (!glfwReady)
     {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return -1;
     }
+    double startupStart = glfwGetTime(); // Startup time is reported from here to the first frame and to the textures being ready
+
+    // Start the job system that runs meshing and other background work on the remaining cores
+    JobSystem jobs;
 
     // Configure GLFW
     // Tells GLFW what version of OpenGL to use. In this case we're using OpenGL 3.3
@@ -37,6 +153,14 @@ int main()
     // That means we only have access to modern functions
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use the core profile of OpenGL
 
+    // Headless runs draw into a framebuffer object; the window only provides the context and is never shown
+    if (headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+    if (surfaceless)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+
     // Create a GLFW window with the specified dimensions and title
     GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "SpaceCraft", NULL, NULL);
     if (!window) // Checks if the window was successfully created
@@ -57,170 +181,411 @@ int main()
         return -1;
     }
 
+    OffscreenTarget offscreen;
+    if (headless)
+    {
+        if (!offscreen.create(WIDTH, HEIGHT))
+        {
+            std::cerr << "Failed to create the offscreen framebuffer" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        glfwSwapInterval(0);
+        std::cout << "Headless: " << options.headlessFrames << " frames of " << WIDTH << "x" << HEIGHT << " on "
+                  << reinterpret_cast<const char *>(glGetString(GL_RENDERER)) << std::endl;
+    }
+
     // ENABLE BLENDING (must be AFTER context + GLAD)
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    // Blocks are real 3D geometry now, so we need depth testing; back faces are never visible
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
     // build and compile our shader program
     // ------------------------------------
-    Shader myShader("../src/myVertexShader.vs", "../src/myFragmentShaderColors.fs");
-    // NOTE: For triangle I'll just reuse this shader even though logically it should have its own shader!
-
-    // Set up vertex data (and buffer(s)) and configure vertex attributes
-    float triangleVertices[] = {
-        // Positions            Colors
-        // x, y, z              r, g, b
-        // (first three values) (last three values)
-        -0.9f, 0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,    // Red, bottom left
-        -0.0f, 0.5f, 0.0f, 0.1f, 0.0f, 0.0f, 1.0f, 0.0f,    // Green, bottom right
-        -0.45f, -0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}; // Blue, top
-
-    GLuint VAOs[2], VBOs[2];
-    glGenVertexArrays(2, VAOs);
-    glGenBuffers(2, VBOs);
-
-    // TRIANGLE SETUP
-    // VAO (Vertex Array Object) stores the configuration of vertex attributes and the bindings of VBOs
-    // Bind the Vertex Array Object first, then bind and set vertex buffer(s), and then configure vertex attributes(s)
-    glBindVertexArray(VAOs[0]);
-
-    // VBO (Vertex Buffer Object) is used to store vertex data in GPU memory
-    // Copy our vertices array in a vertex buffer for OpenGL to use
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(triangleVertices), triangleVertices, GL_STATIC_DRAW);
-
-    // position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-
-    // color attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // texture attribute
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // SQUARE SETUP
-    // Square (two triangles)
-    float squareVertices[] = {
-        //  positions       colors      texCoords (texture coordinates)
-        0.0f, -0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,  // bottom left
-        0.9f, -0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.25f, 0.0f, // bottom right
-        0.9f, 0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.25f, 0.25f, // top right
-        0.0f, 0.5f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.25f}; // top left
-
-    unsigned int squareIndices[] = {0, 1, 2, 0, 2, 3}; // two triangles; first triangle: 0, 1, 2; second triangle: 0, 2, 3;
-                                                       // this is used for EBO, which is Element Buffer Object which means we can reuse vertices
-
-    // VAO and VBO setup for square
-    // VAO is like a container for VBO and attribute settings
-    // VBO is where the actual vertex data is stored
-    glBindVertexArray(VAOs[1]);                                                            // Bind the VAO for the square
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[1]);                                                // Bind the VBO for the square
-    glBufferData(GL_ARRAY_BUFFER, sizeof(squareVertices), squareVertices, GL_STATIC_DRAW); // Copy vertex data to VBO
-
-    // Position attribute of square (location = 0)
-    glVertexAttribPointer(
-        0,                 // layout(location = 0)
-        3,                 // xyz, so 3 components
-        GL_FLOAT,          // type, float
-        GL_FALSE,          // normalized?
-        8 * sizeof(float), // STRIDE: 8 floats per vertex; 8 floats in a row in the array (3 for position, 3 for color, 2 for uv) represent a single vertex; u and v are texture coordinates
-        (void *)0          // OFFSET: start at beginning
-    );
-    glEnableVertexAttribArray(0);
-
-    // Color attribute of square (location = 1)
-    glVertexAttribPointer(
-        1,
-        3,
-        GL_FLOAT,
-        GL_FALSE,
-        8 * sizeof(float),
-        (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Texture coordinate attribute of square (location = 2)
-    glVertexAttribPointer(
-        2,                          // layout(location = 2)
-        2,                          // uv, so 2 components
-        GL_FLOAT,                   // type
-        GL_FALSE,                   // normalized?
-        8 * sizeof(float),          // STRIDE: 8 floats per vertex (3 for position, 3 for color, 2 for uv)
-        (void *)(6 * sizeof(float)) // OFFSET: after the first 6 floats (in other words, skip position and color data)
-    );
-    glEnableVertexAttribArray(2);
-
-    // EBO setup
-    GLuint EBO;            // Element Buffer Object, which is used to store indices
-    glGenBuffers(1, &EBO); // &EBO to get the address of EBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(squareIndices), squareIndices, GL_STATIC_DRAW);
+    // Linked programs are cached on disk, so only the first launch (or one after a shader edit) compiles GLSL
+    ProgramCache programCache(SHADER_CACHE_DIRECTORY, (GLADloadproc)glfwGetProcAddress);
+    double shaderStart = glfwGetTime();
+    Shader myShader("../src/myVertexShader.vs", "../src/myFragmentShaderColors.fs", &programCache);
+    std::cout << "Shader program ready in " << (glfwGetTime() - shaderStart) * 1000.0 << " ms ("
+              << (myShader.fromCache() ? "binary cache" : programCache.available() ? "compiled, now cached" : "compiled, no binary cache support")
+              << ")" << std::endl;
 
     // TEXTURE SETUP
-    GLuint texture;             // Texture variable
-    glGenTextures(1, &texture); // 1 means generate 1 texture; &texture is the address of the texture variable
-
-    glActiveTexture(GL_TEXTURE0); // Explicitly use texture unit 0, which means that when we bind the texture, it will be bound to texture unit 0
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true); // Flip the image vertically on load
-    unsigned char *data = stbi_load("../images/minecraft_textures.jpg", &width, &height, &nrChannels, 0);
-    if (!data)
+    // The build bakes the block textures into a compressed, mip-chained container that is mapped and uploaded as is.
+    // Without it (or without S3TC support), pack the block tiles into an atlas (or load the packed one from the cache
+    // if the images did not change) and cut it into texture array layers on the job system, overlapping the world
+    // loading below. Layers are cut back out of the atlas, so it needs no padding between tiles. Until they are
+    // uploaded the blocks show a placeholder.
+    BlockTextures blockTextures;
+    std::unique_ptr<TextureLoader> textureLoader; // Only while building the layers from the images
+    double bakedStart = glfwGetTime();
+    BakedTexture bakedTextures;
+    if (bakedTextures.open(BAKED_TEXTURE_PATH) && blockTextures.uploadBaked(bakedTextures))
     {
-        std::cerr << "Failed to load texture" << std::endl;
-        return -1;
+        std::cout << "Block textures (" << bakedTextures.layerCount() << " layers, " << bakedFormatName(bakedTextures.format()) << ", "
+                  << bakedTextures.fileSize() / 1024 << " KiB) uploaded from " << BAKED_TEXTURE_PATH << " in "
+                  << (glfwGetTime() - bakedStart) * 1000.0 << " ms" << std::endl;
+    }
+    else
+    {
+        AtlasOptions atlasOptions;
+        atlasOptions.padding = 0;
+        atlasOptions.cacheDirectory = TEXTURE_CACHE_DIRECTORY;
+        textureLoader = std::make_unique<TextureLoader>(jobs, blockTileSources("../images"), atlasOptions, TEXTURE_LAYER_SIZE);
+    }
+    bakedTextures.close(); // The driver has its own copy
+
+    // WORLD SETUP
+    // The world owns all block data; the chunk renderer meshes dirty sections on worker threads and uploads them
+    World world;
+    LightEngine light; // Every block edit goes through it, so the light stays in step with the blocks
+    RegionStorage storage(SAVE_DIRECTORY);
+    ChunkSaver saver(storage);
+    loadWorld(world, light, jobs, storage, WORLD_RADIUS);
+    ChunkRenderer chunkRenderer(jobs, (GLADloadproc)glfwGetProcAddress);
+    std::cout << "Chunk draw path: " << drawPathName(chunkRenderer.drawPath()) << " (B cycles the draw paths)" << std::endl;
+
+    // Camera orbiting the centre of the test world, or following the player walking on it. Both are game logic:
+    // they advance in fixed ticks and the renderer interpolates between them, so the camera moves at the same
+    // speed and just as smoothly at any frame rate. The ticks may run on the simulation thread, so they only
+    // see the keys through the player input, and block edits lock them out while they read the world.
+    Camera camera;
+    float orbitAngle = 0.0f; // Owned by the tick
+    auto orbitState = [&]
+    {
+        // Slowly orbit around the world, always looking at its centre
+        float orbit = WORLD_RADIUS * CHUNK_SIZE * 1.2f;
+        CameraState state;
+        state.position = Vec3{std::sin(orbitAngle) * orbit, 140.0f, std::cos(orbitAngle) * orbit};
+        state.yaw = -orbitAngle;
+        state.pitch = -0.45f;
+        return state;
+    };
+    std::mutex tickMutex;    // Guards the player input and block edits against the ticks
+    PlayerInput playerInput; // Written by the frames
+    PhysicsBody player;      // Owned by the tick, like the rest below
+    CameraState playerView;
+    bool playerSpawned = false;
+    auto walkState = [&](float seconds)
+    {
+        if (!playerSpawned)
+        {
+            // Drop in on the terrain at the centre of the world, looking the way the orbit did
+            RayHit ground = raycast(world, Vec3{0.5f, float(CHUNK_HEIGHT), 0.5f}, Vec3{0.0f, -1.0f, 0.0f}, float(CHUNK_HEIGHT));
+            player = PhysicsBody{};
+            player.position = Vec3{0.5f, ground.hit ? float(ground.block.y + 1) : float(CHUNK_HEIGHT), 0.5f};
+            playerView.yaw = -orbitAngle;
+            playerView.pitch = 0.0f;
+            playerSpawned = true;
+        }
+        playerView.yaw += playerInput.turn * TURN_SPEED * seconds;
+        playerView.pitch = std::clamp(playerView.pitch + playerInput.look * TURN_SPEED * seconds, -1.5f, 1.5f);
+
+        Vec3 forward{std::sin(playerView.yaw), 0.0f, -std::cos(playerView.yaw)};
+        Vec3 right{std::cos(playerView.yaw), 0.0f, std::sin(playerView.yaw)};
+        Vec3 walk = normalize(forward * playerInput.forward + right * playerInput.strafe) * WALK_SPEED;
+        player.velocity.x = walk.x;
+        player.velocity.z = walk.z;
+        if (playerInput.jump && player.onGround)
+            player.velocity.y = JUMP_SPEED;
+        stepBody(world, player, seconds);
+
+        playerView.position = player.position + Vec3{0.0f, EYE_HEIGHT, 0.0f};
+        return playerView;
+    };
+
+    // Mobs, dropped items and projectiles; like the player they belong to the ticks, which update them all
+    EntityRegistry entities;
+    EntitySystems entitySystems;
+    for (int i = 0; i < MOB_GRID * MOB_GRID; ++i)
+    {
+        float spacing = 2.0f * WORLD_RADIUS * CHUNK_SIZE / MOB_GRID;
+        float x = -WORLD_RADIUS * CHUNK_SIZE + (float(i % MOB_GRID) + 0.5f) * spacing;
+        float z = -WORLD_RADIUS * CHUNK_SIZE + (float(i / MOB_GRID) + 0.5f) * spacing;
+        RayHit ground = raycast(world, Vec3{x, float(CHUNK_HEIGHT), z}, Vec3{0.0f, -1.0f, 0.0f}, float(CHUNK_HEIGHT));
+        if (ground.hit)
+            spawnMob(entities, Vec3{x, float(ground.block.y + 1), z}, std::uint32_t(i + 1));
     }
 
-    int format = (nrChannels == 4 ? GL_RGBA : GL_RGB);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
+    TickSnapshots<CameraState> cameraStates;
+    cameraStates.publish(orbitState(), 0.0); // Both snapshots start at the initial state
+    cameraStates.publish(orbitState(), 0.0);
+    SimulationLoop simulation(SIMULATION_RATE, [&](std::uint64_t tick, double seconds)
+    {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        CameraState state;
+        if (playerInput.walking)
+            state = walkState(float(seconds));
+        else
+        {
+            playerSpawned = false;
+            orbitAngle += float(seconds) * 0.1f;
+            state = orbitState();
+        }
+        entitySystems.update(entities, world, float(seconds), &jobs);
+        cameraStates.publish(state, double(tick + 1) * seconds);
+    });
+    if (options.simulationThread)
+        simulation.start();
+    std::cout << "Simulation: " << SIMULATION_RATE << " ticks/s " << (simulation.threaded() ? "on its own thread" : "between frames")
+              << std::endl;
+
+    double lastTitleUpdate = 0.0; // When the stats in the window title were last refreshed
+    double lastAutosave = 0.0;    // When modified chunks were last queued for saving
 
     // Set texture sampler ONCE (program must be active)
     myShader.use();
-    myShader.setInt("myTexture", 0);
+    myShader.setInt("blockTextures", 0);
+    myShader.setInt("sectionOrigins", 1);
+    UniformHandle viewProjectionUniform = myShader.uniform("viewProjection"); // Resolved once, set every frame
+
+    FrameStats frameStats; // Draw calls and texture binds of the current frame, shown in the title bar
+    bool firstFrame = true;
+    double cpuMillis = 0.0;     // CPU time of the frames since the last title update, without the buffer swap
+    int framesSinceTitle = 0;
+    bool drawPathKeyDown = false;
+    bool walkKeyDown = false;
+    bool shootKeyDown = false;
+    bool breakButtonDown = false;
+    bool placeButtonDown = false;
+    RayHit picked; // Block under the mouse cursor, shown in the title bar
+
+    // Headless runs wait for the world to be meshed and uploaded, then time a fixed number of frames
+    bool headlessRecording = false;
+    FrameTimes headlessFrameTimes;
+    headlessFrameTimes.reserve(std::size_t(options.headlessFrames));
 
     while (!glfwWindowShouldClose(window))
     {
         // RENDER LOOP
+        double frameStart = glfwGetTime();
 
         processInput(window); // Check for user input
 
+        // B cycles through the chunk draw paths, to compare CPU frame time and draw calls with and without batching
+        bool drawPathKey = glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS;
+        if (drawPathKey && !drawPathKeyDown)
+        {
+            DrawPath next = chunkRenderer.drawPath() == DrawPath::PER_SECTION ? DrawPath::MULTI_DRAW
+                            : chunkRenderer.drawPath() == DrawPath::MULTI_DRAW && chunkRenderer.multiDrawIndirectSupported()
+                                ? DrawPath::MULTI_DRAW_INDIRECT
+                                : DrawPath::PER_SECTION;
+            chunkRenderer.setDrawPath(next);
+            std::cout << "Chunk draw path: " << drawPathName(next) << std::endl;
+        }
+        drawPathKeyDown = drawPathKey;
+
+        // F switches between the orbiting camera and walking; the keys held are picked up by the next tick
+        if (!headless)
+        {
+            auto axis = [&](int negative, int positive)
+            { return float(glfwGetKey(window, positive) == GLFW_PRESS) - float(glfwGetKey(window, negative) == GLFW_PRESS); };
+            bool walkKey = glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS;
+            std::lock_guard<std::mutex> lock(tickMutex);
+            if (walkKey && !walkKeyDown)
+                playerInput.walking = !playerInput.walking;
+            walkKeyDown = walkKey;
+            playerInput.forward = axis(GLFW_KEY_S, GLFW_KEY_W);
+            playerInput.strafe = axis(GLFW_KEY_A, GLFW_KEY_D);
+            playerInput.turn = axis(GLFW_KEY_LEFT, GLFW_KEY_RIGHT);
+            playerInput.look = axis(GLFW_KEY_DOWN, GLFW_KEY_UP);
+            playerInput.jump = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+
+            // E shoots a projectile along the view
+            bool shootKey = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
+            if (shootKey && !shootKeyDown)
+                shootProjectile(entities, camera.position, camera.forward() * PROJECTILE_SPEED);
+            shootKeyDown = shootKey;
+        }
+
+        // Queue whatever changed in the world for meshing and upload finished meshes within the frame budget
+        chunkRenderer.update(world);
+
+        // Hand the block textures to the GPU once the loader finished, a few layers per frame
+        if (textureLoader && textureLoader->ready())
+        {
+            TextureLayers layers = textureLoader->takeLayers();
+            if (layers.empty())
+                std::cerr << "Failed to load texture, keeping the placeholder" << std::endl;
+            else
+            {
+                std::cout << "Block texture layers (" << layers.count() << " of " << layers.size << "x" << layers.size << ") built in "
+                          << textureLoader->buildMillis() << " ms (atlas " << (textureLoader->fromCache() ? "cached" : "packed") << ")"
+                          << std::endl;
+                blockTextures.beginUpload(std::move(layers));
+            }
+            textureLoader.reset();
+        }
+        if (blockTextures.uploading() && blockTextures.continueUpload())
+            std::cout << "Block textures on the GPU " << (glfwGetTime() - startupStart) * 1000.0 << " ms after startup" << std::endl;
+
+        // Run the ticks that came due (nothing to do when they run on their own thread), then place the camera
+        // between the two newest ones. Headless runs follow the scripted path instead, frame by frame.
+        simulation.pump();
+        if (headless)
+        {
+            CameraState state = scriptedCameraState(int(headlessFrameTimes.count()), options.headlessFrames);
+            camera.position = state.position;
+            camera.yaw = state.yaw;
+            camera.pitch = state.pitch;
+        }
+        else
+        {
+            CameraState previousState, currentState;
+            float alpha;
+            cameraStates.read(simulation.now(), simulation.tickSeconds(), previousState, currentState, alpha);
+            camera.position = lerp(previousState.position, currentState.position, alpha);
+            camera.yaw = previousState.yaw + (currentState.yaw - previousState.yaw) * alpha;
+            camera.pitch = previousState.pitch + (currentState.pitch - previousState.pitch) * alpha;
+        }
+
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        if (headless)
+        {
+            offscreen.bind();
+            framebufferWidth = offscreen.width();
+            framebufferHeight = offscreen.height();
+        }
+        float aspect = framebufferHeight > 0 ? float(framebufferWidth) / float(framebufferHeight) : 1.0f;
+        Mat4 viewProjection = camera.viewProjection(aspect);
+
+        // Pick the block under the mouse cursor every frame; left click breaks it, right click places stone against
+        // the face it points at (a lamp with shift held)
+        if (!headless)
+        {
+            double cursorX, cursorY;
+            int windowWidth, windowHeight;
+            glfwGetCursorPos(window, &cursorX, &cursorY);
+            glfwGetWindowSize(window, &windowWidth, &windowHeight);
+            float ndcX = windowWidth > 0 ? float(cursorX / windowWidth) * 2.0f - 1.0f : 0.0f;
+            float ndcY = windowHeight > 0 ? 1.0f - float(cursorY / windowHeight) * 2.0f : 0.0f;
+            picked = raycast(world, camera.position, camera.rayThrough(ndcX, ndcY, aspect), PICK_REACH);
+
+            bool breakButton = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+            bool placeButton = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
+            std::lock_guard<std::mutex> lock(tickMutex);
+            if (picked.hit && breakButton && !breakButtonDown)
+            {
+                light.setBlock(world, picked.block.x, picked.block.y, picked.block.z, Blocks::AIR);
+                dropItem(entities, Vec3{float(picked.block.x) + 0.5f, float(picked.block.y), float(picked.block.z) + 0.5f}, picked.id);
+            }
+            if (picked.hit && placeButton && !placeButtonDown)
+            {
+                IVec3 target = picked.adjacent();
+                bool lamp = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS;
+                Aabb body = bodyBox(player); // Never place a block where the player stands
+                bool insidePlayer = playerInput.walking && float(target.x) < body.max.x && float(target.x + 1) > body.min.x &&
+                                    float(target.y) < body.max.y && float(target.y + 1) > body.min.y && float(target.z) < body.max.z &&
+                                    float(target.z + 1) > body.min.z;
+                if (!insidePlayer && target.y >= 0 && target.y < CHUNK_HEIGHT && world.getBlock(target.x, target.y, target.z) == Blocks::AIR)
+                    light.setBlock(world, target.x, target.y, target.z, lamp ? Blocks::LAMP : Blocks::STONE);
+            }
+            breakButtonDown = breakButton;
+            placeButtonDown = placeButton;
+        }
+
         // Rendering commands
-        glClearColor(0.0f, 0.875f, 1.0f, 1.0f); // Set the clear color to a nice blue color
-        glClear(GL_COLOR_BUFFER_BIT);           // Clear the color buffer
+        glClearColor(0.0f, 0.875f, 1.0f, 1.0f);               // Set the clear color to a nice blue color
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);   // Clear the color and depth buffers
 
         myShader.use(); // Activate the shader program
-
-        // Triangle (note: still works, but logically should have its own shader)
-        glBindVertexArray(VAOs[0]);
-        glDrawArrays(GL_TRIANGLES, 0, 3);
-
-        // Square (textured + alpha)
-        glActiveTexture(GL_TEXTURE0);          // Activate texture unit 0
-        glBindTexture(GL_TEXTURE_2D, texture); // Bind the texture
-
-        glBindVertexArray(VAOs[1]);                          // Bind the VAO for the square
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); // Draw the square using the EBO
-
+        myShader.setMat4(viewProjectionUniform, viewProjection);
+
+        frameStats.reset();
+        blockTextures.bind(0, frameStats); // All block textures on texture unit 0, one bind per frame
+
+        chunkRenderer.draw(frameStats, Frustum(viewProjection), 1); // Draw the chunk sections in view, origins on unit 1
+
+        // Autosave only serializes here, compression and disk writes happen on the saver thread
+        if (glfwGetTime() - lastAutosave >= AUTOSAVE_SECONDS)
+        {
+            lastAutosave = glfwGetTime();
+            saveModifiedChunks(world, saver);
+        }
+
+        if (headless)
+        {
+            // Wait for the GPU, so the frame time includes rendering (on llvmpipe that is CPU time anyway)
+            glFinish();
+            if (headlessRecording)
+            {
+                headlessFrameTimes.add((glfwGetTime() - frameStart) * 1000.0);
+                if (int(headlessFrameTimes.count()) == options.headlessFrames)
+                    break;
+            }
+            else if (!textureLoader && !blockTextures.uploading() && chunkRenderer.stats().meshingJobs == 0 &&
+                     chunkRenderer.stats().pendingUploads == 0)
+            {
+                headlessRecording = true;
+                std::cout << "World ready " << (glfwGetTime() - startupStart) * 1000.0 << " ms after startup ("
+                          << chunkRenderer.meshCount() << " sections), recording" << std::endl;
+            }
+            glfwPollEvents();
+            continue;
+        }
+
+        // Show the frame timing and chunk geometry VRAM counters in the title bar once per second
+        if (glfwGetTime() - lastTitleUpdate >= 1.0)
+        {
+            double titleInterval = glfwGetTime() - lastTitleUpdate;
+            lastTitleUpdate = glfwGetTime();
+            const ChunkRenderer::Stats &stats = chunkRenderer.stats();
+            const CullStats &cull = chunkRenderer.cullStats();
+            ArenaStats arena = chunkRenderer.arenaStats();
+            SimulationLoop::Stats tickStats = simulation.stats();
+            char timing[160];
+            std::snprintf(timing, sizeof(timing), "%.2f ms frame (%.2f ms CPU), %.0f Hz ticks of %.3f ms (max %.3f, %llu dropped), ",
+                          titleInterval * 1000.0 / std::max(framesSinceTitle, 1), cpuMillis / std::max(framesSinceTitle, 1), SIMULATION_RATE,
+                          tickStats.averageTickMillis, tickStats.maxTickMillis, static_cast<unsigned long long>(tickStats.droppedTicks));
+            std::string title = "SpaceCraft - " + std::string(drawPathName(chunkRenderer.drawPath())) + ": " + timing +
+                                std::to_string(frameStats.drawCalls) + " draws, " +
+                                std::to_string(frameStats.textureBinds) + " texture binds, " + std::to_string(frameStats.triangles / 1000) +
+                                "k triangles, " + std::to_string(cull.sectionsVisible) + "/" + std::to_string(chunkRenderer.meshCount()) +
+                                " sections visible (" + std::to_string(cull.chunksCulled) + " chunks culled, " +
+                                std::to_string(cull.regionsTested + cull.chunksTested + cull.sectionsTested) + " boxes tested), " +
+                                std::to_string((stats.vertexBytes + stats.indexBytes) / 1024) + "/" +
+                                std::to_string((arena.vertices.capacityBytes + arena.indices.capacityBytes) / 1024) + " KiB chunk VRAM (" +
+                                std::to_string(int(arena.vertices.fragmentation * 100.0f)) + "% fragmented), " +
+                                std::to_string(stats.uploadedBytes / 1024) + " KiB uploaded, " +
+                                std::to_string(stats.meshingJobs) + " meshing, " + std::to_string(stats.pendingUploads) + " waiting for upload";
+            {
+                std::lock_guard<std::mutex> lock(tickMutex);
+                title += ", " + std::to_string(entities.count()) + " entities";
+            }
+            if (picked.hit)
+                title += ", pointing at " + std::string(blockInfo(picked.id).name) + " " + std::to_string(int(picked.distance)) + " m away";
+            glfwSetWindowTitle(window, title.c_str());
+            cpuMillis = 0.0;
+            framesSinceTitle = 0;
+        }
+
+        cpuMillis += (glfwGetTime() - frameStart) * 1000.0;
+        ++framesSinceTitle;
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        if (firstFrame)
+        {
+            firstFrame = false;
+            std::cout << "First frame " << (glfwGetTime() - startupStart) * 1000.0 << " ms after startup" << std::endl;
+        }
+    }
+
+    if (headless)
+    {
+        std::cout << "Chunk draw path: " << drawPathName(chunkRenderer.drawPath()) << ", " << frameStats.drawCalls << " draws, "
+                  << frameStats.triangles / 1000 << "k triangles in the last frame" << std::endl;
+        headlessFrameTimes.print("headless");
     }
 
     // Clean up resources
-    glDeleteVertexArrays(2, VAOs);
-    glDeleteBuffers(2, VBOs);
-    glDeleteBuffers(1, &EBO);
-    glDeleteTextures(1, &texture);
+    simulation.stop();
+    saveModifiedChunks(world, saver);
+    saver.flush(); // Make sure everything is on disk before exiting
 
     glfwTerminate();
     return 0;
@@ -235,4 +600,186 @@ void processInput(GLFWwindow *window)
 {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
-}
\ No newline at end of file
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        // The frame count after --headless and --no-render is optional
+        bool countFollows = i + 1 < argc && std::atoi(argv[i + 1]) > 0;
+        if (std::strcmp(argv[i], "--sim-thread") == 0)
+            options.simulationThread = true;
+        else if (std::strcmp(argv[i], "--headless") == 0)
+            options.headlessFrames = countFollows ? std::atoi(argv[++i]) : DEFAULT_SCRIPTED_FRAMES;
+        else if (std::strcmp(argv[i], "--no-render") == 0)
+            options.noRenderFrames = countFollows ? std::atoi(argv[++i]) : DEFAULT_SCRIPTED_FRAMES;
+        else
+        {
+            std::cerr << "Unknown option " << argv[i] << "\n"
+                      << "Usage: " << argv[0] << " [--sim-thread] [--headless [frames]] [--no-render [frames]]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+CameraState scriptedCameraState(int frame, int frames)
+{
+    // One full orbit over the run, rising, sinking and tilting on the way, so what is in view (and what the
+    // culler rejects) changes every frame. Only depends on the frame number, so runs are comparable.
+    float t = float(frame) / float(std::max(frames, 1));
+    float angle = t * 2.0f * PI;
+    float orbit = WORLD_RADIUS * CHUNK_SIZE * (0.6f + 0.6f * t);
+    CameraState state;
+    state.position = Vec3{std::sin(angle) * orbit, 120.0f + 40.0f * std::sin(angle * 2.0f), std::cos(angle) * orbit};
+    state.yaw = -angle + 0.5f * std::sin(angle * 3.0f);
+    state.pitch = -0.45f + 0.25f * std::sin(angle * 5.0f);
+    return state;
+}
+
+int runWithoutRendering(const Options &options)
+{
+    // The world and meshing pipeline of the game without a window or any GL: chunks are loaded, lit, meshed,
+    // then edited (and relit) every frame and re-meshed, and the meshes are thrown away. Each frame waits for its meshes, so the
+    // frame time is the full CPU cost of the edits.
+    using Clock = std::chrono::steady_clock;
+    auto millisSince = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    JobSystem jobs;
+    World world;
+    LightEngine light;
+    RegionStorage storage(SAVE_DIRECTORY);
+    auto loadStart = Clock::now();
+    loadWorld(world, light, jobs, storage, WORLD_RADIUS);
+    std::cout << "No render: " << world.chunkCount() << " chunks loaded in " << millisSince(loadStart) << " ms, " << jobs.workerCount()
+              << " workers" << std::endl;
+
+    MeshingPool pool(jobs);
+    std::size_t meshed = 0;
+    std::size_t triangles = 0;
+    auto drain = [&]
+    {
+        MeshResult result;
+        while (pool.inFlight() > 0)
+        {
+            if (pool.tryPopResult(result))
+            {
+                ++meshed;
+                triangles += result.mesh.triangleCount();
+            }
+            else
+                std::this_thread::yield();
+        }
+    };
+
+    auto meshStart = Clock::now();
+    submitDirtySections(world, pool);
+    drain();
+    std::cout << "Initial meshing: " << meshed << " sections, " << triangles / 1000 << "k triangles in " << millisSince(meshStart) << " ms"
+              << std::endl;
+
+    // Flip blocks at fixed pseudo-random spots (some become lamps); xorshift keeps the sequence the same on every run
+    std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+    auto next = [&rng](int range)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return int(rng % std::uint64_t(range));
+    };
+    int extent = WORLD_RADIUS * CHUNK_SIZE;
+
+    FrameTimes frameTimes;
+    frameTimes.reserve(std::size_t(options.noRenderFrames));
+    std::size_t editMeshed = meshed;
+    auto runStart = Clock::now();
+    for (int frame = 0; frame < options.noRenderFrames; ++frame)
+    {
+        auto frameStart = Clock::now();
+        for (int edit = 0; edit < NO_RENDER_EDITS_PER_FRAME; ++edit)
+        {
+            int x = next(2 * extent) - extent;
+            int y = 32 + next(96);
+            int z = next(2 * extent) - extent;
+            BlockID placed = edit % 4 == 0 ? Blocks::LAMP : Blocks::STONE;
+            light.setBlock(world, x, y, z, world.getBlock(x, y, z) == Blocks::AIR ? placed : BlockID(Blocks::AIR));
+        }
+        submitDirtySections(world, pool);
+        drain();
+        frameTimes.add(millisSince(frameStart));
+    }
+    double runMillis = millisSince(runStart);
+    editMeshed = meshed - editMeshed;
+    std::cout << "Edits: " << options.noRenderFrames * NO_RENDER_EDITS_PER_FRAME << " blocks, " << editMeshed << " sections re-meshed ("
+              << (runMillis > 0.0 ? double(editMeshed) * 1000.0 / runMillis : 0.0) << " sections/s)" << std::endl;
+    frameTimes.print("no-render");
+    return 0;
+}
+
+std::size_t submitDirtySections(World &world, MeshingPool &pool)
+{
+    // Same snapshotting as the chunk renderer, minus the GPU bookkeeping
+    std::size_t submitted = 0;
+    for (auto &[pos, chunk] : world.chunks())
+    {
+        std::uint16_t dirty = chunk->dirtySections();
+        for (int sectionY = 0; dirty && sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+        {
+            if (!(dirty & (1u << sectionY)))
+                continue;
+            chunk->clearDirty(sectionY);
+
+            auto blocks = std::make_unique<PaddedSection>();
+            if (!gatherSection(world, pos, sectionY, *blocks))
+                continue; // All air
+            MeshJob job;
+            job.chunk = pos;
+            job.sectionY = sectionY;
+            job.blocks = std::move(blocks);
+            pool.submit(std::move(job));
+            ++submitted;
+        }
+    }
+    return submitted;
+}
+
+void loadWorld(World &world, LightEngine &light, JobSystem &jobs, RegionStorage &storage, int radius)
+{
+    // Chunks are loaded (or generated when never saved) on the workers, then handed to the world here
+    // since it is not thread-safe
+    TerrainGenerator generator(WORLD_SEED);
+    int side = 2 * radius;
+    std::vector<std::unique_ptr<Chunk>> chunks(std::size_t(side * side));
+    jobs.parallelFor(0, chunks.size(), 1, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            ChunkPos pos{int(i) % side - radius, int(i) / side - radius};
+            chunks[i] = storage.load(pos);
+            if (!chunks[i])
+                chunks[i] = generator.generate(pos);
+        }
+    });
+
+    for (std::unique_ptr<Chunk> &chunk : chunks)
+        world.insertChunk(std::move(chunk));
+
+    // Light is not saved, it follows from the blocks; lit on this thread too, since it spreads across chunks
+    auto lightStart = std::chrono::steady_clock::now();
+    for (const auto &[pos, chunk] : world.chunks())
+        light.lightChunk(world, pos);
+    std::cout << "World lit in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lightStart).count() << " ms"
+              << std::endl;
+}
+
+void saveModifiedChunks(World &world, ChunkSaver &saver)
+{
+    for (auto &[pos, chunk] : world.chunks())
+    {
+        if (!chunk->hasUnsavedChanges())
+            continue;
+        saver.save(*chunk);
+        chunk->markSaved();
+    }
+}
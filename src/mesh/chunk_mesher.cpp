@@ -0,0 +1,222 @@
+#include "mesh/chunk_mesher.h"
+
+namespace
+{
+    constexpr int PADDED = PaddedSection::SIZE;
+
+    void gatherBlocks(const World &world, ChunkPos chunkPos, int sectionY, const ChunkSection &section, PaddedSection &out)
+    {
+        // Look the 3x3 neighbourhood of chunks up once instead of hashing per border block
+        const Chunk *chunks[3][3];
+        for (int dz = -1; dz <= 1; ++dz)
+            for (int dx = -1; dx <= 1; ++dx)
+                chunks[dz + 1][dx + 1] = world.getChunk({chunkPos.x + dx, chunkPos.z + dz});
+
+        int baseY = sectionY * SECTION_SIZE;
+        for (int y = -1; y <= SECTION_SIZE; ++y)
+            for (int z = -1; z <= SECTION_SIZE; ++z)
+                for (int x = -1; x <= SECTION_SIZE; ++x)
+                {
+                    int cx = x < 0 ? 0 : (x >= CHUNK_SIZE ? 2 : 1);
+                    int cz = z < 0 ? 0 : (z >= CHUNK_SIZE ? 2 : 1);
+                    const Chunk *chunk = chunks[cz][cx];
+                    int localX = (x + CHUNK_SIZE) % CHUNK_SIZE;
+                    int localZ = (z + CHUNK_SIZE) % CHUNK_SIZE;
+                    int i = PaddedSection::index(x, y, z);
+                    if (!chunk)
+                    {
+                        out.blocks[i] = Blocks::AIR;
+                        out.light[i] = std::uint8_t(LIGHT_FULL << 4); // Unloaded neighbours are open sky
+                        continue;
+                    }
+                    out.light[i] = std::uint8_t(chunk->skyLight(localX, baseY + y, localZ) << 4 | chunk->blockLight(localX, baseY + y, localZ));
+
+                    bool inside = x >= 0 && x < SECTION_SIZE && y >= 0 && y < SECTION_SIZE && z >= 0 && z < SECTION_SIZE;
+                    out.blocks[i] = inside ? section.getBlock(x, y, z) : chunk->getBlock(localX, baseY + y, localZ);
+                }
+    }
+
+    // AO level of a face corner from the three blocks touching it in the layer in front of the face: two
+    // along the edges and one diagonal. Two edge blocks hide the corner completely, whatever the diagonal.
+    int cornerOcclusion(bool side1, bool side2, bool corner)
+    {
+        return side1 && side2 ? 0 : AO_NONE - (int(side1) + int(side2) + int(corner));
+    }
+
+    // Emits one quad covering [i, i + w) x [j, j + h) of the slice at `depth` along the face's axis.
+    // ao holds the AO level of the corners (0, 0), (w, 0), (w, h) and (0, h) in bits 0-1, 2-3, 4-5 and 6-7.
+    void emitQuad(ChunkMesh &out, int face, int tile, int light, int ao, int depth, int i, int j, int w, int h)
+    {
+        int axis = face / 2;
+        int uAxis = (axis + 1) % 3;
+        int vAxis = (axis + 2) % 3;
+        bool positive = face & 1;
+
+        // Corners in order p0, p0+u, p0+u+v, p0+v; cross(u, v) points along +axis,
+        // so positive faces keep that order and negative faces are reversed to stay counter-clockwise
+        int corners[4][3];
+        const int du[4] = {0, w, w, 0};
+        const int dv[4] = {0, 0, h, h};
+        for (int c = 0; c < 4; ++c)
+        {
+            corners[c][axis] = depth + (positive ? 1 : 0);
+            corners[c][uAxis] = i + du[c];
+            corners[c][vAxis] = j + dv[c];
+        }
+        static const int ORDER_POSITIVE[4] = {0, 1, 2, 3};
+        static const int ORDER_NEGATIVE[4] = {0, 3, 2, 1};
+        const int *order = positive ? ORDER_POSITIVE : ORDER_NEGATIVE;
+
+        std::uint16_t base = std::uint16_t(out.vertexCount());
+        int levels[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            const int *p = corners[order[c]];
+            levels[c] = (ao >> (order[c] * 2)) & 3;
+            // Shading and texture coordinates are derived from the face in the vertex shader
+            out.vertices.push_back(packVertex(p[0], p[1], p[2], Face(face), levels[c], tile, light >> 4, light & 15));
+        }
+
+        // The GPU interpolates across each triangle separately, so with one darker corner the split decides
+        // whether the shadow fills half the quad or fades evenly; split along the darker diagonal
+        if (levels[0] + levels[2] > levels[1] + levels[3])
+            out.indices.insert(out.indices.end(), {std::uint16_t(base + 1), std::uint16_t(base + 2), std::uint16_t(base + 3),
+                                                   std::uint16_t(base + 1), std::uint16_t(base + 3), base});
+        else
+            out.indices.insert(out.indices.end(), {base, std::uint16_t(base + 1), std::uint16_t(base + 2),
+                                                   base, std::uint16_t(base + 2), std::uint16_t(base + 3)});
+    }
+}
+
+bool gatherSection(const World &world, ChunkPos chunkPos, int sectionY, PaddedSection &out)
+{
+    const Chunk *chunk = world.getChunk(chunkPos);
+    if (!chunk)
+        return false;
+    const ChunkSection *section = chunk->section(sectionY);
+    if (!section)
+        return false;
+
+    gatherBlocks(world, chunkPos, sectionY, *section, out);
+    return true;
+}
+
+void buildSectionMesh(const World &world, ChunkPos chunkPos, int sectionY, ChunkMesh &out, const MeshOptions &options)
+{
+    PaddedSection blocks;
+    if (gatherSection(world, chunkPos, sectionY, blocks))
+        buildSectionMesh(blocks, out, options);
+    else
+        out.clear();
+}
+
+void buildSectionMesh(const PaddedSection &blocks, ChunkMesh &out, const MeshOptions &options)
+{
+    out.clear();
+
+    // One 16x16 mask per slice: 0 where no face is visible, otherwise atlas tile + 1 in the low bits, then the
+    // light in front of the face and the AO of its four corners, so only faces that look the same merge
+    constexpr int LIGHT_SHIFT = 9; // Tiles are 0..255
+    constexpr int AO_SHIFT = 17;
+    constexpr std::uint32_t AO_UNOCCLUDED = AO_NONE * 0x55u; // AO_NONE in all four corners
+    std::uint32_t mask[SECTION_SIZE * SECTION_SIZE];
+
+    // Opacity of the padded blocks, looked up once: the visibility test reads every block and AO reads up
+    // to eight around every visible face
+    std::uint8_t opaque[PADDED * PADDED * PADDED];
+    for (int i = 0; i < PADDED * PADDED * PADDED; ++i)
+        opaque[i] = isOpaque(blocks.blocks[i]);
+
+    // Strides of the x, y and z axes inside the padded array
+    const int strides[3] = {1, PADDED * PADDED, PADDED};
+    const int first = (PADDED + 1) * PADDED + 1; // Index of block (0, 0, 0)
+
+    for (int face = 0; face < int(Face::COUNT); ++face)
+    {
+        int axis = face / 2;
+        int uAxis = (axis + 1) % 3;
+        int vAxis = (axis + 2) % 3;
+        int uStride = strides[uAxis];
+        int vStride = strides[vAxis];
+        int neighbourOffset = (face & 1) ? strides[axis] : -strides[axis];
+
+        for (int depth = 0; depth < SECTION_SIZE; ++depth)
+        {
+            // Build the visibility mask of this slice
+            bool any = false;
+            int sliceStart = first + depth * strides[axis];
+            for (int j = 0; j < SECTION_SIZE; ++j)
+                for (int i = 0; i < SECTION_SIZE; ++i)
+                {
+                    int index = sliceStart + i * uStride + j * vStride;
+                    BlockID id = blocks.blocks[index];
+                    std::uint32_t key = 0;
+                    int front = index + neighbourOffset;
+                    if (id != Blocks::AIR && !opaque[front])
+                    {
+                        std::uint32_t ao = AO_UNOCCLUDED;
+                        if (options.ambientOcclusion)
+                        {
+                            // Corners (0, 0), (1, 0), (1, 1), (0, 1) of the face in (u, v)
+                            const std::uint8_t *layer = opaque + front;
+                            bool uMinus = layer[-uStride], uPlus = layer[uStride];
+                            bool vMinus = layer[-vStride], vPlus = layer[vStride];
+                            ao = std::uint32_t(cornerOcclusion(uMinus, vMinus, layer[-uStride - vStride])) |
+                                 std::uint32_t(cornerOcclusion(uPlus, vMinus, layer[uStride - vStride])) << 2 |
+                                 std::uint32_t(cornerOcclusion(uPlus, vPlus, layer[uStride + vStride])) << 4 |
+                                 std::uint32_t(cornerOcclusion(uMinus, vPlus, layer[-uStride + vStride])) << 6;
+                        }
+                        key = std::uint32_t(blockInfo(id).tiles[face] + 1) | (std::uint32_t(blocks.light[front]) << LIGHT_SHIFT) |
+                              (ao << AO_SHIFT);
+                        any = true;
+                    }
+                    mask[j * SECTION_SIZE + i] = key;
+                }
+            if (!any)
+                continue;
+
+            // Greedily grow each unvisited face first along u, then along v
+            for (int j = 0; j < SECTION_SIZE; ++j)
+                for (int i = 0; i < SECTION_SIZE;)
+                {
+                    std::uint32_t key = mask[j * SECTION_SIZE + i];
+                    if (!key)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    // A face with uneven AO keeps its own quad, stretching its gradient across a merged quad would
+                    // darken blocks that are not occluded at all
+                    int w = 1;
+                    int h = 1;
+                    std::uint32_t ao = key >> AO_SHIFT;
+                    if (options.greedy && ao == (ao & 3u) * 0x55u)
+                    {
+                        while (i + w < SECTION_SIZE && mask[j * SECTION_SIZE + i + w] == key)
+                            ++w;
+                        for (bool grow = true; grow && j + h < SECTION_SIZE;)
+                        {
+                            for (int k = 0; k < w; ++k)
+                                if (mask[(j + h) * SECTION_SIZE + i + k] != key)
+                                {
+                                    grow = false;
+                                    break;
+                                }
+                            if (grow)
+                                ++h;
+                        }
+                    }
+
+                    int tile = int(key & ((1u << LIGHT_SHIFT) - 1)) - 1;
+                    int light = int((key >> LIGHT_SHIFT) & 0xFFu);
+                    emitQuad(out, face, tile, light, int(ao), depth, i, j, w, h);
+
+                    for (int dj = 0; dj < h; ++dj)
+                        for (int di = 0; di < w; ++di)
+                            mask[(j + dj) * SECTION_SIZE + i + di] = 0;
+                    i += w;
+                }
+        }
+    }
+}
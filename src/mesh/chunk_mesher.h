@@ -0,0 +1,61 @@
+#ifndef CHUNK_MESHER_H
+#define CHUNK_MESHER_H
+
+#include <array>   // For the padded block copy
+#include <cstdint> // For std::uint16_t
+#include <vector>  // For the vertex and index arrays
+
+#include "mesh/vertex_format.h"
+#include "world/world.h"
+
+// Vertices are section-local (see vertex_format.h), the renderer supplies the section origin.
+// A section has at most 16^3 / 2 * 6 visible faces of four vertices, i.e. 49152 vertices, so 16-bit indices suffice.
+struct ChunkMesh
+{
+    std::vector<PackedVertex> vertices;
+    std::vector<std::uint16_t> indices;
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+    }
+    bool empty() const { return indices.empty(); }
+    std::size_t vertexCount() const { return vertices.size(); }
+    std::size_t triangleCount() const { return indices.size() / 3; }
+    std::size_t byteSize() const { return vertices.size() * sizeof(PackedVertex) + indices.size() * sizeof(std::uint16_t); }
+};
+
+struct MeshOptions
+{
+    bool greedy = true;           // Merge coplanar faces with the same texture, light and AO into larger quads
+    bool ambientOcclusion = true; // Darken face corners by the blocks around them (else every corner is AO_NONE)
+};
+
+// Copy of a section plus a one block border from its neighbours. Meshing only reads this copy,
+// so it can run on a worker thread while the world keeps changing.
+struct PaddedSection
+{
+    static constexpr int SIZE = SECTION_SIZE + 2;
+
+    std::array<BlockID, SIZE * SIZE * SIZE> blocks{};
+    std::array<std::uint8_t, SIZE * SIZE * SIZE> light{}; // Sky light << 4 | block light, same layout
+
+    // x, y, z in [-1, SECTION_SIZE]
+    static int index(int x, int y, int z) { return ((y + 1) * SIZE + (z + 1)) * SIZE + (x + 1); }
+    BlockID at(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+    BlockID &at(int x, int y, int z) { return blocks[index(x, y, z)]; }
+};
+
+// Copies a section and its border out of the world. Returns false (and leaves out untouched)
+// if the section holds only air, in which case there is nothing to mesh.
+bool gatherSection(const World &world, ChunkPos chunkPos, int sectionY, PaddedSection &out);
+
+// Builds the mesh of one 16x16x16 section. Only faces between a solid block and a
+// non-opaque neighbour are emitted, lit by the light of that neighbour.
+void buildSectionMesh(const PaddedSection &blocks, ChunkMesh &out, const MeshOptions &options = {});
+
+// Convenience overload: gathers the section from the world and meshes it on the calling thread
+void buildSectionMesh(const World &world, ChunkPos chunkPos, int sectionY, ChunkMesh &out, const MeshOptions &options = {});
+
+#endif
@@ -0,0 +1,18 @@
+#include "mesh/meshing_pool.h"
+
+void MeshingPool::submit(MeshJob job)
+{
+    m_inFlight->fetch_add(1, std::memory_order_relaxed);
+
+    // std::function must be copyable, so the move-only job travels in a shared_ptr
+    auto shared = std::make_shared<MeshJob>(std::move(job));
+    m_jobs.schedule([shared, results = m_results]
+    {
+        MeshResult result;
+        result.chunk = shared->chunk;
+        result.sectionY = shared->sectionY;
+        result.version = shared->version;
+        buildSectionMesh(*shared->blocks, result.mesh, shared->options);
+        results->push(std::move(result));
+    });
+}
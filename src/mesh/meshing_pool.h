@@ -0,0 +1,65 @@
+#ifndef MESHING_POOL_H
+#define MESHING_POOL_H
+
+#include <atomic>  // For the in-flight counter
+#include <cstdint> // For std::uint32_t
+#include <memory>  // For std::unique_ptr
+
+#include "core/job_system.h"
+#include "core/mpsc_queue.h"
+#include "mesh/chunk_mesher.h"
+
+// A section snapshot waiting to be meshed
+struct MeshJob
+{
+    ChunkPos chunk;
+    int sectionY = 0;
+    std::uint32_t version = 0;             // Lets the receiver drop results that were superseded
+    std::unique_ptr<PaddedSection> blocks; // Snapshot taken on the main thread
+    MeshOptions options;
+};
+
+// A finished mesh travelling back to the render thread
+struct MeshResult
+{
+    ChunkPos chunk;
+    int sectionY = 0;
+    std::uint32_t version = 0;
+    ChunkMesh mesh;
+};
+
+// Meshes section snapshots as jobs on the engine's job system.
+// Finished meshes come back through a lock-free queue that the render thread drains.
+class MeshingPool
+{
+public:
+    explicit MeshingPool(JobSystem &jobs) : m_jobs(jobs) {}
+
+    MeshingPool(const MeshingPool &) = delete;
+    MeshingPool &operator=(const MeshingPool &) = delete;
+
+    void submit(MeshJob job);
+
+    // Render thread only: fetches one finished mesh if there is any
+    bool tryPopResult(MeshResult &out)
+    {
+        if (!m_results->tryPop(out))
+            return false;
+        m_inFlight->fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Jobs submitted whose result has not been popped yet
+    std::size_t inFlight() const { return m_inFlight->load(std::memory_order_relaxed); }
+
+    unsigned threadCount() const { return m_jobs.workerCount(); }
+
+private:
+    JobSystem &m_jobs;
+
+    // Shared with the queued jobs, so a job finishing after the pool is gone still has somewhere to write
+    std::shared_ptr<MpscQueue<MeshResult>> m_results = std::make_shared<MpscQueue<MeshResult>>();
+    std::shared_ptr<std::atomic<std::size_t>> m_inFlight = std::make_shared<std::atomic<std::size_t>>(0);
+};
+
+#endif
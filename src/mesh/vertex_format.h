@@ -0,0 +1,51 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <cstdint> // For std::uint32_t
+
+#include "world/block.h"
+
+// Chunk vertex packed into 8 bytes (the old interleaved float vertex was 32 bytes).
+// Decoded in myVertexShader.vs, keep both in sync.
+//
+// data0: bits  0-4  x      section-local corner position, 0..16
+//        bits  5-9  y
+//        bits 10-14 z
+//        bits 15-17 face   Face enum value, gives the normal and the texture orientation
+//        bits 18-19 ao     ambient occlusion level, 0 (darkest) .. 3 (unoccluded)
+//        bits 20-31 slot   low 12 bits of the section slot
+// data1: bits  0-15 tile   texture tile index
+//        bits 16-19 sky    sky light level, 0..15
+//        bits 20-23 block  block light level, 0..15
+//        bits 24-31 slot   high 8 bits of the section slot
+//
+// The slot indexes the renderer's table of section origins. All sections share one vertex buffer and are
+// drawn together, so the vertex itself has to say which section it belongs to; the mesher leaves it 0 and
+// the renderer fills it in at upload (setSectionSlot).
+struct PackedVertex
+{
+    std::uint32_t data0;
+    std::uint32_t data1;
+};
+static_assert(sizeof(PackedVertex) == 8, "PackedVertex must stay 8 bytes, the shader reads it as a uvec2");
+
+constexpr int AO_NONE = 3;     // AO level of a corner with no occluding neighbours
+constexpr int LIGHT_FULL = 15; // Brightest light level
+constexpr std::uint32_t MAX_SECTION_SLOTS = 1u << 20;
+
+inline PackedVertex packVertex(int x, int y, int z, Face face, int ao, int tile, int skyLight, int blockLight)
+{
+    PackedVertex v;
+    v.data0 = std::uint32_t(x) | (std::uint32_t(y) << 5) | (std::uint32_t(z) << 10) |
+              (std::uint32_t(face) << 15) | (std::uint32_t(ao) << 18);
+    v.data1 = std::uint32_t(tile) | (std::uint32_t(skyLight) << 16) | (std::uint32_t(blockLight) << 20);
+    return v;
+}
+
+inline void setSectionSlot(PackedVertex &v, std::uint32_t slot)
+{
+    v.data0 = (v.data0 & 0x000FFFFFu) | (slot << 20);
+    v.data1 = (v.data1 & 0x00FFFFFFu) | ((slot >> 12) << 24);
+}
+
+#endif
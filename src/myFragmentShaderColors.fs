@@ -4,9 +4,12 @@ out vec4 FragColor; // Output color of the fragment
 
 // Fetched from vertex shader
 in vec3 myColor;
-in vec2 TexCoord;
+in vec2 TexCoord;       // Position across the quad in blocks
+flat in int tileIndex;  // Texture array layer of the face
 
-uniform sampler2D myTexture; // Texture sampler (bound to texture unit 0?)
+// Block textures, one layer per tile (bound to texture unit 0). The layers wrap with GL_REPEAT and have
+// their own mip chains, so a greedy quad spanning several blocks samples straight across block seams.
+uniform sampler2DArray blockTextures;
 
 void main()
 {
@@ -15,8 +18,11 @@ void main()
     // FragColor = texture(myTexture, TexCoord) * vec4(1.0, 1.0, 1.0, 0.8); // Apply 20% transparency
     // FragColor = texture(myTexture, TexCoord) * vec4(1.0, 1.0, 1.0, 1.0); // Apply 20% transparency
 
+    // TexCoord counts blocks, so the texture repeats once per block
+    vec4 texel = texture(blockTextures, vec3(TexCoord, float(tileIndex)));
+
     // Mixing the texture color with vertex color (optional)
-    FragColor = texture(myTexture, TexCoord) * vec4(myColor, 1.0);
+    FragColor = texel * vec4(myColor, 1.0);
 
     // FragColor = texture(myTexture, TexCoord) * vec4(1.0);
     // FragColor = texture(myTexture, TexCoord);
@@ -1,17 +1,52 @@
 #version 330 core
-layout(location=0) in vec3 aPos;
-layout(location=1) in vec3 aColor;
-layout(location=2) in vec2 aTexCoord;
+// Packed 8-byte chunk vertex, see mesh/vertex_format.h for the bit layout
+layout(location=0) in uvec2 aPacked;
 
 out vec3 myColor;
-out vec2 TexCoord;
+out vec2 TexCoord;      // Position across the face in blocks, the texture repeats once per block
+flat out int tileIndex; // Texture array layer of the face
 
 //uniform float scale; // Controls the scale of the vertices
+uniform mat4 viewProjection; // Camera projection * view
+uniform isamplerBuffer sectionOrigins; // World position of the (0, 0, 0) corner of every section, by slot
+
+// Cheap directional shading so the cube faces are distinguishable (indexed by face: -X, +X, -Y, +Y, -Z, +Z)
+const float FACE_SHADE[6] = float[6](0.8, 0.8, 0.5, 1.0, 0.65, 0.65);
+// Brightness per ambient occlusion level, 0 = corner fully enclosed, 3 = unoccluded
+const float AO_CURVE[4] = float[4](0.45, 0.65, 0.82, 1.0);
+const vec3 BLOCK_LIGHT_TINT = vec3(1.0, 0.85, 0.65);
 
 void main()
 {
-    gl_Position = vec4(aPos,1.0);
+    // Unpack the vertex
+    vec3 local = vec3(aPacked.x & 31u, (aPacked.x >> 5) & 31u, (aPacked.x >> 10) & 31u);
+    uint face = (aPacked.x >> 15) & 7u;
+    uint ao = (aPacked.x >> 18) & 3u;
+    uint tile = aPacked.y & 0xFFFFu;
+    float skyLight = float((aPacked.y >> 16) & 15u);
+    float blockLight = float((aPacked.y >> 20) & 15u);
+    uint slot = (aPacked.x >> 20) | ((aPacked.y >> 24) << 12);
+    vec3 sectionOrigin = vec3(texelFetch(sectionOrigins, int(slot)).xyz);
+
+    gl_Position = viewProjection * vec4(sectionOrigin + local, 1.0);
     // gl_Position = vec4(aPos.x + aPos.x * scale, aPos.y + aPos.y * scale, aPos.z + aPos.z * scale, 1.0); // Outputs the positions/coordinates of all vertices
-    myColor = aColor;
-    TexCoord = aTexCoord;
+
+    // Texture coordinates follow from the face, keeping side textures upright and unmirrored
+    if (face == 0u)
+        TexCoord = vec2(local.z, local.y);
+    else if (face == 1u)
+        TexCoord = vec2(16.0 - local.z, local.y);
+    else if (face == 2u)
+        TexCoord = vec2(local.x, local.z);
+    else if (face == 3u)
+        TexCoord = vec2(local.x, 16.0 - local.z);
+    else if (face == 4u)
+        TexCoord = vec2(16.0 - local.x, local.y);
+    else
+        TexCoord = vec2(local.x, local.y);
+
+    // Each light level is 80% as bright as the one above it; block light (lamps) is warmer than daylight
+    vec3 light = max(vec3(pow(0.8, 15.0 - skyLight)), BLOCK_LIGHT_TINT * pow(0.8, 15.0 - blockLight));
+    myColor = FACE_SHADE[face] * AO_CURVE[ao] * light;
+    tileIndex = int(tile);
 }
@@ -0,0 +1,155 @@
+#include "render/block_textures.h"
+
+#include <algorithm> // For std::min
+#include <cstring>   // For std::memcpy
+#include <utility>   // For std::move
+
+#include "render/gl_extensions.h"
+
+namespace
+{
+    // From GL_EXT_texture_compression_s3tc (not in the generated 3.3 loader)
+    constexpr GLenum COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+    constexpr GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+}
+
+BlockTextures::BlockTextures()
+{
+    // 2x2 grey checkerboard; repeated once per block it reads as a dull tiled floor until the real textures arrive
+    const std::uint8_t checker[16] = {96, 96, 96, 255, 160, 160, 160, 255, 160, 160, 160, 255, 96, 96, 96, 255};
+
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+    setSampling();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 2, 2, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, checker);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+BlockTextures::~BlockTextures()
+{
+    glDeleteTextures(1, &m_texture);
+    if (m_pending)
+        glDeleteTextures(1, &m_pending);
+    if (m_pbo)
+        glDeleteBuffers(1, &m_pbo);
+}
+
+void BlockTextures::setSampling()
+{
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void BlockTextures::beginUpload(TextureLayers layers)
+{
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (layers.empty() || layers.count() > maxLayers || uploading())
+        return;
+
+    m_source = std::move(layers);
+    m_nextLayer = 0;
+
+    // Storage for level 0 only; glGenerateMipmap allocates the rest once every layer is in
+    glGenTextures(1, &m_pending);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_pending);
+    setSampling();
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_source.size, m_source.size, m_source.count(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    glGenBuffers(1, &m_pbo);
+}
+
+bool BlockTextures::uploadBaked(const BakedTexture &baked)
+{
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    bool compressed = baked.format() != BakedFormat::RGBA8;
+    if (!baked.isOpen() || baked.layerCount() > maxLayers || uploading() ||
+        (compressed && !hasGlExtension("GL_EXT_texture_compression_s3tc")))
+        return false;
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    setSampling();
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, baked.mipCount() - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Straight out of the file mapping: the driver copies the pages, nothing is decoded or filtered here
+    GLenum internalFormat = baked.format() == BakedFormat::BC1 ? COMPRESSED_RGB_S3TC_DXT1 : COMPRESSED_RGBA_S3TC_DXT5;
+    for (int mip = 0; mip < baked.mipCount(); ++mip)
+    {
+        BakedTexture::Level level = baked.level(mip);
+        if (compressed)
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, mip, internalFormat, level.size, level.size, baked.layerCount(), 0, GLsizei(level.bytes),
+                                   level.data);
+        else
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, mip, GL_RGBA8, level.size, level.size, baked.layerCount(), 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    glDeleteTextures(1, &m_texture);
+    m_texture = texture;
+    m_layers = baked.layerCount();
+    return true;
+}
+
+bool BlockTextures::continueUpload(std::size_t maxBytes)
+{
+    if (!uploading())
+        return true;
+
+    std::size_t layerBytes = std::size_t(m_source.size) * std::size_t(m_source.size) * 4;
+    int count = int(std::min<std::size_t>(std::max<std::size_t>(maxBytes / layerBytes, 1), std::size_t(m_source.count() - m_nextLayer)));
+    std::size_t bytes = layerBytes * std::size_t(count);
+
+    // Orphan the buffer so the driver hands out fresh memory instead of waiting for last frame's copy, fill
+    // it and let glTexSubImage3D read from it; the transfer into the texture then runs asynchronously
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(bytes), nullptr, GL_STREAM_DRAW);
+    void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(bytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped)
+    {
+        std::memcpy(mapped, m_source.layer(m_nextLayer), bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_pending);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, m_nextLayer, m_source.size, m_source.size, count, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        m_nextLayer += count;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); // A bound unpack buffer would turn every later pixel pointer into an offset
+
+    if (m_nextLayer < m_source.count())
+        return false;
+    finishUpload();
+    return true;
+}
+
+void BlockTextures::finishUpload()
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_pending);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY); // Mip levels shrink width and height only, never the layer count
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    glDeleteTextures(1, &m_texture);
+    glDeleteBuffers(1, &m_pbo);
+    m_texture = m_pending;
+    m_layers = m_source.count();
+    m_pending = 0;
+    m_pbo = 0;
+    m_source = {};
+}
+
+void BlockTextures::bind(GLuint unit, FrameStats &frame) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+    ++frame.textureBinds;
+}
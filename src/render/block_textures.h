@@ -0,0 +1,59 @@
+#ifndef BLOCK_TEXTURES_H
+#define BLOCK_TEXTURES_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <cstddef> // For std::size_t
+
+#include "render/frame_stats.h"
+#include "texture/baked_texture.h"
+#include "texture/texture_array.h"
+
+// The block face textures as one GL_TEXTURE_2D_ARRAY, one layer per tile. glGenerateMipmap filters each
+// layer on its own, so distant faces never pick up colours from other tiles, and GL_REPEAT lets a greedy
+// quad spanning several blocks repeat its texture without any per-fragment wrapping in the shader.
+//
+// Starts out as a one-layer grey checkerboard placeholder (array lookups clamp the layer, so every tile
+// index shows it). beginUpload() hands over the real layers, which continueUpload() streams into a second
+// texture through a pixel buffer object a few layers per frame; the placeholder is swapped out once the
+// last layer and the mipmaps are in. A baked container skips all of that: uploadBaked() hands its mapped
+// mip levels to the driver directly.
+class BlockTextures
+{
+public:
+    // Needs a current context
+    BlockTextures();
+    ~BlockTextures();
+
+    BlockTextures(const BlockTextures &) = delete;
+    BlockTextures &operator=(const BlockTextures &) = delete;
+
+    void beginUpload(TextureLayers layers);
+    // Copies whole layers into the PBO until maxBytes is reached (at least one layer); true when done
+    bool continueUpload(std::size_t maxBytes = 4 * 1024 * 1024);
+
+    // Replaces the textures with a baked container, every mip level included; false (placeholder kept) if its
+    // format is compressed and the driver lacks S3TC, or there are too many layers
+    bool uploadBaked(const BakedTexture &baked);
+
+    bool uploading() const { return m_pending != 0; }
+    bool ready() const { return m_layers > 0; } // Real textures in place, not the placeholder
+    int layerCount() const { return m_layers; }
+
+    void bind(GLuint unit, FrameStats &frame) const;
+
+private:
+    static void setSampling();
+    void finishUpload();
+
+    GLuint m_texture = 0; // What bind() binds: the placeholder until an upload finished
+    int m_layers = 0;
+
+    // Upload in progress
+    GLuint m_pending = 0; // Texture being filled
+    GLuint m_pbo = 0;
+    TextureLayers m_source;
+    int m_nextLayer = 0;
+};
+
+#endif
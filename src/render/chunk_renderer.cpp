@@ -0,0 +1,322 @@
+#include "render/chunk_renderer.h"
+
+#include <algorithm> // For std::max, std::min
+#include <chrono>    // For timing the per-frame upload budget
+
+#include "render/gl_extensions.h"
+
+namespace
+{
+    // From GL 4.3 / GL_ARB_multi_draw_indirect (not in the generated 3.3 loader)
+    constexpr GLenum DRAW_INDIRECT_BUFFER = 0x8F3F;
+
+    constexpr std::size_t INITIAL_ORIGIN_SLOTS = 4096;
+    constexpr std::size_t INDIRECT_BYTES_PER_FRAME = 1024 * 1024; // ~52k draw commands
+}
+
+const char *drawPathName(DrawPath path)
+{
+    switch (path)
+    {
+    case DrawPath::PER_SECTION:
+        return "per section";
+    case DrawPath::MULTI_DRAW:
+        return "multi-draw";
+    case DrawPath::MULTI_DRAW_INDIRECT:
+        return "multi-draw indirect";
+    }
+    return "?";
+}
+
+ChunkRenderer::ChunkRenderer(JobSystem &jobs, GLADloadproc loader) : m_pool(jobs)
+{
+    glGenBuffers(1, &m_originBuffer);
+    glGenTextures(1, &m_originTexture);
+    m_originCapacity = INITIAL_ORIGIN_SLOTS;
+    glBindBuffer(GL_TEXTURE_BUFFER, m_originBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(m_originCapacity * 4 * sizeof(GLint)), nullptr, GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, m_originTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32I, m_originBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Vertices carry 20 bits of slot, and the origin table is one buffer texture texel per slot
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    m_maxSlots = maxTexels > 0 ? std::min(MAX_SECTION_SLOTS, std::uint32_t(maxTexels)) : MAX_SECTION_SLOTS;
+
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    bool supported = major > 4 || (major == 4 && minor >= 3) || hasGlExtension("GL_ARB_multi_draw_indirect");
+    if (loader && supported)
+        m_multiDrawIndirect = reinterpret_cast<MultiDrawElementsIndirectProc>(loader("glMultiDrawElementsIndirect"));
+    if (m_multiDrawIndirect)
+    {
+        m_indirect = std::make_unique<StreamBuffer>(DRAW_INDIRECT_BUFFER, INDIRECT_BYTES_PER_FRAME, loader);
+        m_drawPath = DrawPath::MULTI_DRAW_INDIRECT;
+    }
+}
+
+ChunkRenderer::~ChunkRenderer()
+{
+    for (auto &[key, section] : m_sections)
+        destroy(section);
+    glDeleteTextures(1, &m_originTexture);
+    glDeleteBuffers(1, &m_originBuffer);
+}
+
+void ChunkRenderer::setDrawPath(DrawPath path)
+{
+    if (path == DrawPath::MULTI_DRAW_INDIRECT && !m_multiDrawIndirect)
+        return;
+    m_drawPath = path;
+}
+
+std::uint64_t ChunkRenderer::sectionKey(ChunkPos pos, int sectionY)
+{
+    // 28 bits per horizontal coordinate is plenty (+-134M chunks) and leaves 8 bits for the section
+    return (std::uint64_t(std::uint32_t(pos.x) & 0x0FFFFFFF) << 36) |
+           (std::uint64_t(std::uint32_t(pos.z) & 0x0FFFFFFF) << 8) |
+           std::uint64_t(sectionY);
+}
+
+void ChunkRenderer::update(World &world, const UploadBudget &budget)
+{
+    // Drop sections whose chunk was unloaded; results still being meshed for them are discarded on arrival
+    for (auto it = m_sections.begin(); it != m_sections.end();)
+    {
+        if (!world.getChunk(it->second.chunk))
+        {
+            destroy(it->second);
+            it = m_sections.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    queueDirtySections(world);
+
+    // Collect everything the workers finished since last frame
+    MeshResult result;
+    while (m_pool.tryPopResult(result))
+        m_finished.push_back(std::move(result));
+
+    uploadFinishedMeshes(budget);
+
+    // Close the holes remeshing leaves in the arena while nothing else is being uploaded
+    m_stats.defragBytesLastFrame = m_stats.uploadsLastFrame == 0 && m_finished.empty() ? m_arena.defragment(budget.defragBytes) : 0;
+
+    ArenaStats arena = m_arena.stats();
+    m_stats.vertexBytes = arena.vertices.usedBytes;
+    m_stats.indexBytes = arena.indices.usedBytes;
+    m_stats.meshingJobs = m_pool.inFlight();
+    m_stats.pendingUploads = m_finished.size();
+}
+
+void ChunkRenderer::queueDirtySections(World &world)
+{
+    for (auto &[pos, chunk] : world.chunks())
+    {
+        std::uint16_t dirty = chunk->dirtySections();
+        if (!dirty)
+            continue;
+
+        for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+        {
+            if (!(dirty & (1u << sectionY)))
+                continue;
+            chunk->clearDirty(sectionY);
+
+            SectionState &state = m_sections[sectionKey(pos, sectionY)];
+            state.chunk = pos;
+            state.sectionY = sectionY;
+            ++state.version; // Any older job still in flight is now stale
+
+            // The snapshot is taken here, on the thread that owns the world, so workers never touch it
+            auto blocks = std::make_unique<PaddedSection>();
+            if (!gatherSection(world, pos, sectionY, *blocks))
+            {
+                destroy(state); // Section became all air
+                continue;
+            }
+
+            MeshJob job;
+            job.chunk = pos;
+            job.sectionY = sectionY;
+            job.version = state.version;
+            job.blocks = std::move(blocks);
+            m_pool.submit(std::move(job));
+        }
+    }
+}
+
+void ChunkRenderer::uploadFinishedMeshes(const UploadBudget &budget)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t bytes = 0;
+    std::size_t uploads = 0;
+
+    while (!m_finished.empty())
+    {
+        if (uploads > 0)
+        {
+            double elapsedMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (bytes >= budget.maxBytes || elapsedMillis >= budget.maxMillis)
+                break; // Out of budget, the rest waits for the next frame
+        }
+
+        MeshResult result = std::move(m_finished.front());
+        m_finished.pop_front();
+
+        auto it = m_sections.find(sectionKey(result.chunk, result.sectionY));
+        if (it == m_sections.end() || it->second.version != result.version)
+            continue; // Chunk unloaded or section changed again after this job was queued
+
+        if (result.mesh.empty())
+            destroy(it->second);
+        else
+            upload(it->second, result.mesh);
+        bytes += result.mesh.byteSize();
+        ++uploads;
+    }
+
+    m_stats.uploadsLastFrame = uploads;
+}
+
+std::uint32_t ChunkRenderer::acquireSlot(ChunkPos chunk, int sectionY)
+{
+    std::uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = std::uint32_t(m_origins.size() / 4);
+        if (slot >= m_maxSlots)
+            return NO_SLOT; // A larger slot would wrap in the vertex and draw at another section's origin
+        m_origins.resize(m_origins.size() + 4);
+    }
+
+    GLint *origin = &m_origins[std::size_t(slot) * 4];
+    origin[0] = chunk.x * CHUNK_SIZE;
+    origin[1] = sectionY * SECTION_SIZE;
+    origin[2] = chunk.z * CHUNK_SIZE;
+    origin[3] = 0;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, m_originBuffer);
+    if (slot >= m_originCapacity)
+    {
+        // Reallocate with everything in it; the buffer texture follows the buffer object, not its storage
+        m_originCapacity = std::min(std::max(m_originCapacity * 2, std::size_t(slot) + 1), std::size_t(m_maxSlots));
+        glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(m_originCapacity * 4 * sizeof(GLint)), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, GLsizeiptr(m_origins.size() * sizeof(GLint)), m_origins.data());
+    }
+    else
+        glBufferSubData(GL_TEXTURE_BUFFER, GLintptr(slot) * 4 * GLintptr(sizeof(GLint)), 4 * sizeof(GLint), origin);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    return slot;
+}
+
+void ChunkRenderer::upload(SectionState &section, ChunkMesh &data)
+{
+    if (section.slot == NO_SLOT)
+    {
+        section.slot = acquireSlot(section.chunk, section.sectionY);
+        if (section.slot == NO_SLOT)
+        {
+            ++m_stats.meshesWithoutSlot;
+            return;
+        }
+        ++m_meshCount;
+        m_culler.add(section.chunk, section.sectionY);
+    }
+
+    // Remeshed sections get a new range: the size changed, and the old range may still be read by queued draws
+    for (PackedVertex &vertex : data.vertices)
+        setSectionSlot(vertex, section.slot);
+    m_arena.free(section.mesh);
+    section.mesh = m_arena.upload(data);
+    m_stats.uploadedBytes += data.byteSize();
+}
+
+void ChunkRenderer::destroy(SectionState &section)
+{
+    if (section.slot == NO_SLOT)
+        return;
+
+    --m_meshCount;
+    m_culler.remove(section.chunk, section.sectionY);
+    m_freeSlots.push_back(section.slot);
+    section.slot = NO_SLOT;
+    m_arena.free(section.mesh);
+    section.mesh = NO_MESH;
+}
+
+void ChunkRenderer::draw(FrameStats &frame, const Frustum &frustum, GLuint originUnit)
+{
+    m_culler.cull(frustum, m_visible, m_cullStats);
+    if (m_visible.empty())
+        return;
+
+    glActiveTexture(GL_TEXTURE0 + originUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, m_originTexture);
+    ++frame.textureBinds;
+    glBindVertexArray(m_arena.vao());
+
+    // Indirect commands are written straight into this frame's region of the stream buffer; if it is
+    // full the frame falls back to the client-side multi-draw lists
+    IndirectCommand *commands = nullptr;
+    StreamBuffer::Allocation allocation;
+    if (m_drawPath == DrawPath::MULTI_DRAW_INDIRECT)
+    {
+        m_indirect->beginFrame();
+        allocation = m_indirect->allocate(m_visible.size() * sizeof(IndirectCommand), alignof(IndirectCommand));
+        commands = static_cast<IndirectCommand *>(allocation.data);
+    }
+
+    m_counts.clear();
+    m_offsets.clear();
+    m_baseVertices.clear();
+    for (const VisibleSection &visible : m_visible)
+    {
+        const MeshRange &mesh = m_arena.range(m_sections.find(sectionKey(visible.chunk, visible.sectionY))->second.mesh);
+        frame.triangles += mesh.indexCount / 3;
+        if (commands)
+        {
+            *commands++ = {mesh.indexCount, 1, mesh.firstIndex, GLint(mesh.firstVertex), 0};
+            continue;
+        }
+        m_counts.push_back(GLsizei(mesh.indexCount));
+        m_offsets.push_back(reinterpret_cast<const void *>(std::uintptr_t(mesh.firstIndex) * sizeof(std::uint16_t)));
+        m_baseVertices.push_back(GLint(mesh.firstVertex));
+    }
+
+    if (commands)
+    {
+        m_indirect->flush();
+        glBindBuffer(DRAW_INDIRECT_BUFFER, m_indirect->buffer());
+        m_multiDrawIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, reinterpret_cast<const void *>(allocation.offset), GLsizei(m_visible.size()), 0);
+        glBindBuffer(DRAW_INDIRECT_BUFFER, 0);
+        ++frame.drawCalls;
+    }
+    else if (m_drawPath == DrawPath::PER_SECTION)
+    {
+        for (std::size_t i = 0; i < m_counts.size(); ++i)
+            glDrawElementsBaseVertex(GL_TRIANGLES, m_counts[i], GL_UNSIGNED_SHORT, m_offsets[i], m_baseVertices[i]);
+        frame.drawCalls += m_counts.size();
+    }
+    else
+    {
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_counts.data(), GL_UNSIGNED_SHORT, m_offsets.data(), GLsizei(m_counts.size()),
+                                      m_baseVertices.data());
+        ++frame.drawCalls;
+    }
+    if (m_drawPath == DrawPath::MULTI_DRAW_INDIRECT)
+        m_indirect->endFrame();
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,157 @@
+#ifndef CHUNK_RENDERER_H
+#define CHUNK_RENDERER_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <cstdint>       // For std::uint64_t section keys
+#include <deque>         // For meshes waiting to be uploaded
+#include <memory>        // For std::unique_ptr
+#include <unordered_map> // For the per-section GPU meshes
+#include <vector>        // For the sections visible this frame
+
+#include "core/frustum.h"
+#include "mesh/chunk_mesher.h"
+#include "mesh/meshing_pool.h"
+#include "render/frame_stats.h"
+#include "render/mesh_arena.h"
+#include "render/stream_buffer.h"
+#include "world/section_culler.h"
+#include "world/world.h"
+
+// Limits how much finished geometry is uploaded per frame so frame time stays flat while the world streams in.
+// At least one mesh is always uploaded so progress never stalls.
+struct UploadBudget
+{
+    std::size_t maxBytes = 4 * 1024 * 1024; // Vertex + index bytes per frame
+    double maxMillis = 2.0;                 // Time spent in glBufferSubData per frame
+    std::size_t defragBytes = 1024 * 1024;  // Moved inside the mesh arena in frames with nothing to upload
+};
+
+// How the visible sections are submitted. All of them read the same shared buffers through one VAO.
+enum class DrawPath
+{
+    PER_SECTION,         // One glDrawElementsBaseVertex per section (the unbatched reference)
+    MULTI_DRAW,          // One glMultiDrawElementsBaseVertex per frame (GL 3.3)
+    MULTI_DRAW_INDIRECT, // One glMultiDrawElementsIndirect per frame, commands streamed through a StreamBuffer (GL 4.3)
+};
+
+const char *drawPathName(DrawPath path);
+
+// Owns the GPU memory of every section mesh and keeps it in sync with the world.
+// Dirty sections are snapshotted on the render thread, meshed on the job system and
+// uploaded back on the render thread within the upload budget.
+//
+// Meshes are suballocated from one shared vertex and index buffer (MeshArena). Each section also gets a
+// slot in a buffer texture holding its world origin, and every vertex carries that slot, so a single
+// multi-draw call draws all visible sections without any per-section state changes.
+class ChunkRenderer
+{
+public:
+    // Needs a current context; loader (the function given to gladLoadGLLoader) is used to load
+    // glMultiDrawElementsIndirect, which the 3.3 loader lacks. Without it, or without driver support,
+    // the renderer uses MULTI_DRAW.
+    ChunkRenderer(JobSystem &jobs, GLADloadproc loader = nullptr);
+    ~ChunkRenderer();
+
+    ChunkRenderer(const ChunkRenderer &) = delete;
+    ChunkRenderer &operator=(const ChunkRenderer &) = delete;
+
+    // Queues dirty sections for meshing, drops meshes of unloaded chunks and uploads finished meshes
+    void update(World &world, const UploadBudget &budget = {});
+
+    // Draws the section meshes inside the frustum and counts the draw calls in frame; the shader and block
+    // textures must already be bound. Sections are culled before any GL call (see SectionCuller).
+    // The section origins are bound to originUnit, the shader's sectionOrigins sampler must use it.
+    void draw(FrameStats &frame, const Frustum &frustum, GLuint originUnit = 1);
+
+    // MULTI_DRAW_INDIRECT is only accepted when supported
+    void setDrawPath(DrawPath path);
+    DrawPath drawPath() const { return m_drawPath; }
+    bool multiDrawIndirectSupported() const { return m_multiDrawIndirect != nullptr; }
+
+    // VRAM accounting for chunk geometry plus the state of the streaming pipeline
+    struct Stats
+    {
+        std::size_t vertexBytes = 0;     // Used by meshes in the shared vertex buffer
+        std::size_t indexBytes = 0;      // Used by meshes in the shared index buffer
+        std::uint64_t uploadedBytes = 0; // Total ever sent with glBufferSubData (upload bandwidth)
+        std::size_t defragBytesLastFrame = 0;
+        std::size_t meshingJobs = 0;     // Sections being meshed on worker threads
+        std::size_t pendingUploads = 0;  // Finished meshes waiting for upload budget
+        std::size_t uploadsLastFrame = 0;
+        std::uint64_t meshesWithoutSlot = 0; // Meshes left undrawn because every section origin slot was taken
+    };
+    const Stats &stats() const { return m_stats; }
+
+    std::size_t meshCount() const { return m_meshCount; }
+
+    // Occupancy and fragmentation of the shared geometry buffers
+    ArenaStats arenaStats() const { return m_arena.stats(); }
+
+    // Regions, chunk columns and sections tested and culled by the last draw
+    const CullStats &cullStats() const { return m_cullStats; }
+
+private:
+    static constexpr std::uint32_t NO_SLOT = ~0u;
+
+    // Everything the renderer knows about one section; exists as soon as the section was queued once
+    struct SectionState
+    {
+        MeshHandle mesh = NO_MESH;    // NO_MESH while the section has no geometry on the GPU
+        std::uint32_t slot = NO_SLOT; // Origin table entry, held while the section has a mesh
+        ChunkPos chunk;
+        int sectionY = 0;
+        std::uint32_t version = 0;    // Version of the newest job, older results are discarded
+    };
+
+    // Layout of GL's DrawElementsIndirectCommand
+    struct IndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    using MultiDrawElementsIndirectProc = void(APIENTRYP)(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount, GLsizei stride);
+
+    static std::uint64_t sectionKey(ChunkPos pos, int sectionY);
+    void queueDirtySections(World &world);
+    void uploadFinishedMeshes(const UploadBudget &budget);
+    void upload(SectionState &section, ChunkMesh &data);
+    void destroy(SectionState &section);
+    // NO_SLOT once all m_maxSlots are in use
+    std::uint32_t acquireSlot(ChunkPos chunk, int sectionY);
+
+    MeshingPool m_pool;
+    std::unordered_map<std::uint64_t, SectionState> m_sections;
+    std::deque<MeshResult> m_finished; // Popped from the pool but not uploaded yet
+    std::size_t m_meshCount = 0;
+    Stats m_stats;
+
+    SectionCuller m_culler; // Holds every section with a GPU mesh
+    std::vector<VisibleSection> m_visible;
+    CullStats m_cullStats;
+
+    MeshArena m_arena;
+
+    // Section origins as a buffer texture of ivec4 (x, y, z, unused), indexed by slot
+    GLuint m_originBuffer = 0;
+    GLuint m_originTexture = 0;
+    std::vector<GLint> m_origins;     // CPU copy, four values per slot, for re-uploading when the buffer grows
+    std::size_t m_originCapacity = 0; // Slots the GPU buffer holds
+    std::uint32_t m_maxSlots = 0;     // Slots a vertex can address and the buffer texture can hold
+    std::vector<std::uint32_t> m_freeSlots;
+
+    DrawPath m_drawPath = DrawPath::MULTI_DRAW;
+    MultiDrawElementsIndirectProc m_multiDrawIndirect = nullptr;
+    std::unique_ptr<StreamBuffer> m_indirect; // Draw commands, only with multi-draw indirect
+
+    // Per-frame draw lists, kept to avoid allocating every frame
+    std::vector<GLsizei> m_counts;
+    std::vector<const void *> m_offsets;
+    std::vector<GLint> m_baseVertices;
+};
+
+#endif
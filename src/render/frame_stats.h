@@ -0,0 +1,16 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <cstddef> // For std::size_t
+
+// GL work issued during one frame, counted by whoever issues it and shown in the stats overlay
+struct FrameStats
+{
+    std::size_t drawCalls = 0;
+    std::size_t textureBinds = 0;
+    std::size_t triangles = 0;
+
+    void reset() { *this = {}; }
+};
+
+#endif
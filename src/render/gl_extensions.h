@@ -0,0 +1,22 @@
+#ifndef GL_EXTENSIONS_H
+#define GL_EXTENSIONS_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <cstring> // For std::strcmp
+
+// True if the current context advertises the extension (core profile: one string per index, no glGetString list)
+inline bool hasGlExtension(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const GLubyte *extension = glGetStringi(GL_EXTENSIONS, GLuint(i));
+        if (extension && std::strcmp(reinterpret_cast<const char *>(extension), name) == 0)
+            return true;
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "render/mesh_arena.h"
+
+#include <algorithm> // For std::max
+
+namespace
+{
+    // Meshes at the end of a buffer looked at per defragment() call before giving up on finding holes
+    constexpr int MAX_COMPACT_CANDIDATES = 64;
+}
+
+MeshArena::MeshArena(std::uint32_t vertexCapacity, std::uint32_t indexCapacity)
+{
+    m_vertices.target = GL_ARRAY_BUFFER;
+    m_vertices.elementBytes = sizeof(PackedVertex);
+    m_vertices.allocator.grow(vertexCapacity);
+    m_indices.target = GL_ELEMENT_ARRAY_BUFFER;
+    m_indices.elementBytes = sizeof(std::uint16_t);
+    m_indices.allocator.grow(indexCapacity);
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vertices.id);
+    glGenBuffers(1, &m_indices.id);
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertices.id);
+    glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(std::size_t(vertexCapacity) * m_vertices.elementBytes), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indices.id); // The EBO binding is stored in the VAO
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(std::size_t(indexCapacity) * m_indices.elementBytes), nullptr, GL_STATIC_DRAW);
+    bindVertexLayout();
+    glBindVertexArray(0);
+}
+
+MeshArena::~MeshArena()
+{
+    glDeleteVertexArrays(1, &m_vao);
+    glDeleteBuffers(1, &m_vertices.id);
+    glDeleteBuffers(1, &m_indices.id);
+}
+
+void MeshArena::bindVertexLayout() const
+{
+    // One packed vertex = two 32-bit integers read as a uvec2 (location = 0).
+    // The I variant keeps them as integers instead of converting to float.
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertices.id);
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(PackedVertex), (void *)0);
+    glEnableVertexAttribArray(0);
+}
+
+void MeshArena::grow(Buffer &buffer, std::uint32_t count)
+{
+    // Double until the request fits at the end, whatever free space there is elsewhere
+    std::uint32_t oldCapacity = buffer.allocator.capacity();
+    std::uint32_t capacity = std::max(oldCapacity, 1024u);
+    while (capacity - oldCapacity < count)
+        capacity *= 2;
+
+    GLuint grown = 0;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(std::size_t(capacity) * buffer.elementBytes), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer.id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, GLsizeiptr(std::size_t(oldCapacity) * buffer.elementBytes));
+    glDeleteBuffers(1, &buffer.id);
+    buffer.id = grown;
+
+    glBindVertexArray(m_vao);
+    if (&buffer == &m_vertices)
+        bindVertexLayout(); // The attribute still points at the old buffer
+    else
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id);
+    glBindVertexArray(0);
+
+    buffer.allocator.grow(capacity);
+    ++m_growths;
+}
+
+std::uint32_t MeshArena::allocate(Buffer &buffer, std::uint32_t count)
+{
+    std::uint32_t offset = buffer.allocator.allocate(count);
+    if (offset != RangeAllocator::INVALID)
+        return offset;
+    grow(buffer, count);
+    return buffer.allocator.allocate(count);
+}
+
+MeshHandle MeshArena::upload(const ChunkMesh &mesh)
+{
+    if (mesh.empty())
+        return NO_MESH;
+
+    MeshHandle handle;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = MeshHandle(m_meshes.size());
+        m_meshes.emplace_back();
+    }
+    ++m_meshCount;
+
+    MeshRange &range = m_meshes[handle];
+    range.vertexCount = std::uint32_t(mesh.vertices.size());
+    range.indexCount = std::uint32_t(mesh.indices.size());
+    range.firstVertex = allocate(m_vertices, range.vertexCount);
+    range.firstIndex = allocate(m_indices, range.indexCount);
+    m_vertices.owners.emplace(range.firstVertex, handle);
+    m_indices.owners.emplace(range.firstIndex, handle);
+
+    // The VAO is not needed for the copies, binding the targets directly keeps its EBO binding untouched
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertices.id);
+    glBufferSubData(GL_ARRAY_BUFFER, GLintptr(range.firstVertex) * GLintptr(sizeof(PackedVertex)),
+                    GLsizeiptr(mesh.vertices.size() * sizeof(PackedVertex)), mesh.vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_indices.id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, GLintptr(range.firstIndex) * GLintptr(sizeof(std::uint16_t)),
+                    GLsizeiptr(mesh.indices.size() * sizeof(std::uint16_t)), mesh.indices.data());
+    return handle;
+}
+
+void MeshArena::free(MeshHandle handle)
+{
+    if (handle == NO_MESH)
+        return;
+    MeshRange &range = m_meshes[handle];
+    m_vertices.allocator.free(range.firstVertex, range.vertexCount);
+    m_indices.allocator.free(range.firstIndex, range.indexCount);
+    m_vertices.owners.erase(range.firstVertex);
+    m_indices.owners.erase(range.firstIndex);
+    range = {};
+    m_freeHandles.push_back(handle);
+    --m_meshCount;
+}
+
+std::size_t MeshArena::compact(Buffer &buffer, std::size_t maxBytes)
+{
+    bool vertices = &buffer == &m_vertices;
+    std::size_t moved = 0;
+    int candidates = 0;
+
+    // Walk down from the last range, moving each into the best fitting hole below it. Source and destination
+    // never overlap (the hole is free space below the range), which glCopyBufferSubData requires within one buffer.
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer.id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.id);
+    for (auto it = buffer.owners.end(); it != buffer.owners.begin() && moved < maxBytes && candidates < MAX_COMPACT_CANDIDATES;)
+    {
+        --it;
+        ++candidates;
+        auto [offset, handle] = *it;
+        MeshRange &range = m_meshes[handle];
+        std::uint32_t count = vertices ? range.vertexCount : range.indexCount;
+        std::uint32_t target = buffer.allocator.allocateBelow(count, offset);
+        if (target == RangeAllocator::INVALID)
+            continue;
+
+        std::size_t bytes = std::size_t(count) * buffer.elementBytes;
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, GLintptr(std::size_t(offset) * buffer.elementBytes),
+                            GLintptr(std::size_t(target) * buffer.elementBytes), GLsizeiptr(bytes));
+        buffer.allocator.free(offset, count);
+        it = buffer.owners.erase(it);
+        buffer.owners.emplace(target, handle);
+        (vertices ? range.firstVertex : range.firstIndex) = target;
+
+        moved += bytes;
+        ++m_moves;
+    }
+    m_movedBytes += moved;
+    return moved;
+}
+
+std::size_t MeshArena::defragment(std::size_t maxBytes)
+{
+    std::size_t moved = compact(m_vertices, maxBytes);
+    if (moved < maxBytes)
+        moved += compact(m_indices, maxBytes - moved);
+    return moved;
+}
+
+ArenaBufferStats MeshArena::bufferStats(const Buffer &buffer)
+{
+    ArenaBufferStats stats;
+    stats.capacityBytes = std::size_t(buffer.allocator.capacity()) * buffer.elementBytes;
+    stats.usedBytes = std::size_t(buffer.allocator.used()) * buffer.elementBytes;
+    stats.freeRanges = buffer.allocator.freeRangeCount();
+    stats.largestFreeBytes = std::size_t(buffer.allocator.largestFreeRange()) * buffer.elementBytes;
+    stats.fragmentation = buffer.allocator.fragmentation();
+    return stats;
+}
+
+ArenaStats MeshArena::stats() const
+{
+    ArenaStats stats;
+    stats.vertices = bufferStats(m_vertices);
+    stats.indices = bufferStats(m_indices);
+    stats.meshes = m_meshCount;
+    stats.growths = m_growths;
+    stats.moves = m_moves;
+    stats.movedBytes = m_movedBytes;
+    return stats;
+}
@@ -0,0 +1,113 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For range offsets and handles
+#include <map>     // For the owners of each range, by offset
+#include <vector>  // For the mesh table
+
+#include "core/range_allocator.h"
+#include "mesh/chunk_mesher.h"
+
+// Where one mesh lives inside the arena, in vertices and indices (not bytes). Indices stay relative to
+// the mesh's first vertex, draws add firstVertex back as the base vertex.
+struct MeshRange
+{
+    std::uint32_t firstVertex = RangeAllocator::INVALID;
+    std::uint32_t vertexCount = 0;
+    std::uint32_t firstIndex = RangeAllocator::INVALID;
+    std::uint32_t indexCount = 0;
+
+    bool empty() const { return indexCount == 0; }
+};
+
+using MeshHandle = std::uint32_t;
+constexpr MeshHandle NO_MESH = ~0u;
+
+// Occupancy and fragmentation of one of the arena's buffers
+struct ArenaBufferStats
+{
+    std::size_t capacityBytes = 0;
+    std::size_t usedBytes = 0;
+    std::size_t freeRanges = 0;
+    std::size_t largestFreeBytes = 0;
+    float fragmentation = 0.0f; // 1 - largest free range / total free space
+
+    float occupancy() const { return capacityBytes ? float(usedBytes) / float(capacityBytes) : 0.0f; }
+};
+
+struct ArenaStats
+{
+    ArenaBufferStats vertices;
+    ArenaBufferStats indices;
+    std::size_t meshes = 0;
+    std::size_t growths = 0;      // Times a buffer was reallocated bigger
+    std::size_t moves = 0;        // Ranges moved by defragment()
+    std::uint64_t movedBytes = 0; // Bytes copied by defragment()
+};
+
+// Every chunk mesh in one shared vertex buffer and one shared index buffer, behind a single VAO, so any
+// number of meshes can be drawn without rebinding anything (and with one multi-draw call). The buffers
+// live as long as the arena; chunks remeshing all the time only move ranges around inside them instead of
+// creating and deleting GL buffers.
+//
+// Ranges are handed out best fit (RangeAllocator). When a buffer is full it doubles: the new buffer receives
+// the old contents with glCopyBufferSubData. Meshes are referred to by handle rather than by range, so
+// defragment() can move them towards the start of the buffers (GPU side copies) while their owners only
+// look the range up again when drawing.
+class MeshArena
+{
+public:
+    // Needs a current context; capacities are in vertices and indices
+    explicit MeshArena(std::uint32_t vertexCapacity = 1u << 20, std::uint32_t indexCapacity = 3u << 19);
+    ~MeshArena();
+
+    MeshArena(const MeshArena &) = delete;
+    MeshArena &operator=(const MeshArena &) = delete;
+
+    // Reserves room for the mesh (growing the buffers if needed) and uploads it; NO_MESH for an empty mesh
+    MeshHandle upload(const ChunkMesh &mesh);
+    void free(MeshHandle handle);
+
+    const MeshRange &range(MeshHandle handle) const { return m_meshes[handle]; }
+
+    // Moves meshes from the end of the buffers into free ranges further down until maxBytes were copied,
+    // closing the holes remeshing leaves behind. Meant for frames with nothing else to upload.
+    // Returns the bytes copied.
+    std::size_t defragment(std::size_t maxBytes);
+
+    GLuint vao() const { return m_vao; }
+
+    ArenaStats stats() const;
+
+private:
+    struct Buffer
+    {
+        GLuint id = 0;
+        GLenum target = 0;
+        std::size_t elementBytes = 0;
+        RangeAllocator allocator;
+        std::map<std::uint32_t, MeshHandle> owners; // First element -> mesh, for picking what to move
+    };
+
+    std::uint32_t allocate(Buffer &buffer, std::uint32_t count);
+    void grow(Buffer &buffer, std::uint32_t count);
+    std::size_t compact(Buffer &buffer, std::size_t maxBytes);
+    static ArenaBufferStats bufferStats(const Buffer &buffer);
+    void bindVertexLayout() const;
+
+    GLuint m_vao = 0;
+    Buffer m_vertices;
+    Buffer m_indices;
+
+    std::vector<MeshRange> m_meshes; // Indexed by handle
+    std::vector<MeshHandle> m_freeHandles;
+    std::size_t m_meshCount = 0;
+    std::size_t m_growths = 0;
+    std::size_t m_moves = 0;
+    std::uint64_t m_movedBytes = 0;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef OFFSCREEN_TARGET_H
+#define OFFSCREEN_TARGET_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+// Framebuffer object with a colour and a depth-stencil renderbuffer, for rendering without a visible window
+// (headless benchmarks). Renderbuffers rather than textures, since nothing samples the result.
+class OffscreenTarget
+{
+public:
+    OffscreenTarget() = default;
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget &) = delete;
+    OffscreenTarget &operator=(const OffscreenTarget &) = delete;
+
+    // Needs a current context; false (and nothing allocated) if the framebuffer is incomplete
+    bool create(int width, int height);
+
+    // Makes it the draw target and sets the viewport to cover it
+    void bind() const;
+    static void unbind() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+private:
+    void destroy();
+
+    GLuint m_framebuffer = 0;
+    GLuint m_color = 0;
+    GLuint m_depth = 0;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "render/program_cache.h"
+
+#include <cstdio>     // For std::snprintf
+#include <filesystem> // For creating the cache directory and atomic replacement
+#include <fstream>    // For reading and writing cache files
+#include <utility>    // For std::move
+#include <vector>     // For binary buffers
+
+#include "render/gl_extensions.h"
+
+namespace
+{
+    // From GL_ARB_get_program_binary (not in the generated 3.3 loader)
+    constexpr GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+    constexpr GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+    constexpr GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+    // File layout: header followed by the driver's binary blob
+    struct CacheHeader
+    {
+        std::uint32_t magic = 0x42504353; // "SCPB"
+        std::uint32_t version = 1;
+        std::uint64_t key = 0;
+        std::uint32_t binaryFormat = 0;
+        std::uint32_t length = 0;
+    };
+
+    std::uint64_t fnv1a(std::uint64_t hash, const std::string &text)
+    {
+        for (unsigned char c : text)
+        {
+            hash ^= c;
+            hash *= 0x100000001B3ull;
+        }
+        // Separator, so ("ab", "c") and ("a", "bc") hash differently
+        hash ^= 0xFF;
+        return hash * 0x100000001B3ull;
+    }
+
+    std::string glString(GLenum name)
+    {
+        const GLubyte *value = glGetString(name);
+        return value ? reinterpret_cast<const char *>(value) : "";
+    }
+}
+
+ProgramCache::ProgramCache(std::string directory, GLADloadproc loader) : m_directory(std::move(directory))
+{
+    m_driver = glString(GL_VENDOR) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    bool supported = major > 4 || (major == 4 && minor >= 1) || hasGlExtension("GL_ARB_get_program_binary");
+    if (!supported)
+        return;
+
+    m_getProgramBinary = reinterpret_cast<GetProgramBinaryProc>(loader("glGetProgramBinary"));
+    m_programBinary = reinterpret_cast<ProgramBinaryProc>(loader("glProgramBinary"));
+    m_programParameteri = reinterpret_cast<ProgramParameteriProc>(loader("glProgramParameteri"));
+
+    // Some drivers expose the extension but support zero binary formats, which makes it useless
+    GLint formats = 0;
+    glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+    m_available = m_getProgramBinary && m_programBinary && m_programParameteri && formats > 0;
+}
+
+std::uint64_t ProgramCache::key(const std::string &vertexSource, const std::string &fragmentSource) const
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    hash = fnv1a(hash, m_driver);
+    hash = fnv1a(hash, vertexSource);
+    return fnv1a(hash, fragmentSource);
+}
+
+std::string ProgramCache::path(std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_directory + "/" + name;
+}
+
+GLuint ProgramCache::load(std::uint64_t key) const
+{
+    if (!m_available)
+        return 0;
+
+    std::ifstream file(path(key), std::ios::binary);
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != CacheHeader().magic ||
+        header.version != CacheHeader().version || header.key != key)
+        return 0;
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), std::streamsize(binary.size())))
+        return 0;
+
+    GLuint program = glCreateProgram();
+    m_programBinary(program, header.binaryFormat, binary.data(), GLsizei(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        // Rejected (driver changed in a way the version string did not show); the caller recompiles
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ProgramCache::prepare(GLuint program) const
+{
+    if (m_available)
+        m_programParameteri(program, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ProgramCache::store(std::uint64_t key, GLuint program) const
+{
+    if (!m_available)
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(program, PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    CacheHeader header;
+    header.key = key;
+    GLsizei written = 0;
+    GLenum format = 0;
+    m_getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return false;
+    header.binaryFormat = format;
+    header.length = std::uint32_t(written);
+
+    // Write to a temporary file and rename it, so a crash never leaves a half-written entry behind
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    std::string target = path(key);
+    std::string temporary = target + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char *>(&header), sizeof(header)) || !file.write(binary.data(), written))
+            return false;
+    }
+    std::filesystem::rename(temporary, target, error);
+    return !error;
+}
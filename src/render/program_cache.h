@@ -0,0 +1,46 @@
+#ifndef PROGRAM_CACHE_H
+#define PROGRAM_CACHE_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <cstdint> // For std::uint64_t keys
+#include <string>  // For the cache directory
+
+// On-disk cache of linked shader programs (GL_ARB_get_program_binary), so startup skips GLSL compilation.
+// Entries are keyed by a hash of the shader sources plus the vendor, renderer and driver version strings;
+// a driver update or any source edit changes the key, and a binary the driver rejects is simply recompiled.
+// The loader in glad only covers core 3.3, so the three extension entry points are loaded here.
+class ProgramCache
+{
+public:
+    // Needs a current context; loader is the same function given to gladLoadGLLoader
+    ProgramCache(std::string directory, GLADloadproc loader);
+
+    // False when the driver has no program binary support (or no binary formats); load/store then do nothing
+    bool available() const { return m_available; }
+
+    std::uint64_t key(const std::string &vertexSource, const std::string &fragmentSource) const;
+
+    // A linked program created from the cached binary, or 0 if there is none or the driver rejected it
+    GLuint load(std::uint64_t key) const;
+    // Call before glLinkProgram so the driver keeps the binary around
+    void prepare(GLuint program) const;
+    // Writes the binary of a successfully linked program; false on failure
+    bool store(std::uint64_t key, GLuint program) const;
+
+private:
+    using GetProgramBinaryProc = void(APIENTRYP)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+    using ProgramBinaryProc = void(APIENTRYP)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+    using ProgramParameteriProc = void(APIENTRYP)(GLuint program, GLenum pname, GLint value);
+
+    std::string path(std::uint64_t key) const;
+
+    std::string m_directory;
+    std::string m_driver; // Vendor, renderer and version, part of every key
+    bool m_available = false;
+    GetProgramBinaryProc m_getProgramBinary = nullptr;
+    ProgramBinaryProc m_programBinary = nullptr;
+    ProgramParameteriProc m_programParameteri = nullptr;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "render/stream_buffer.h"
+
+#include <chrono> // For timing stalls
+
+#include "render/gl_extensions.h"
+
+namespace
+{
+    // From GL 4.4 / GL_ARB_buffer_storage (not in the generated 3.3 loader)
+    constexpr GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+    constexpr GLbitfield MAP_COHERENT_BIT = 0x0080;
+}
+
+StreamBuffer::StreamBuffer(GLenum target, std::size_t bytesPerFrame, GLADloadproc loader, bool persistent)
+    : m_target(target), m_regionBytes(bytesPerFrame)
+{
+    std::size_t totalBytes = m_regionBytes * STREAM_FRAMES;
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(m_target, m_buffer);
+
+    BufferStorageProc bufferStorage = nullptr;
+    if (loader && persistent)
+    {
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major > 4 || (major == 4 && minor >= 4) || hasGlExtension("GL_ARB_buffer_storage"))
+            bufferStorage = reinterpret_cast<BufferStorageProc>(loader("glBufferStorage"));
+    }
+
+    if (bufferStorage)
+    {
+        // Coherent, so writes become visible without glFlushMappedBufferRange or a memory barrier
+        GLbitfield flags = GL_MAP_WRITE_BIT | MAP_PERSISTENT_BIT | MAP_COHERENT_BIT;
+        bufferStorage(m_target, GLsizeiptr(totalBytes), nullptr, flags);
+        m_mapped = static_cast<std::uint8_t *>(glMapBufferRange(m_target, 0, GLsizeiptr(totalBytes), flags));
+    }
+    if (!m_mapped)
+    {
+        // Immutable storage cannot be respecified, so start over with a new buffer for the fallback
+        if (bufferStorage)
+        {
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            glBindBuffer(m_target, m_buffer);
+        }
+        glBufferData(m_target, GLsizeiptr(totalBytes), nullptr, GL_STREAM_DRAW);
+        m_staging.resize(m_regionBytes);
+    }
+    glBindBuffer(m_target, 0);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (GLsync &fence : m_fences)
+        if (fence)
+            glDeleteSync(fence);
+    if (m_mapped)
+    {
+        glBindBuffer(m_target, m_buffer);
+        glUnmapBuffer(m_target);
+        glBindBuffer(m_target, 0);
+    }
+    glDeleteBuffers(1, &m_buffer);
+}
+
+void StreamBuffer::beginFrame()
+{
+    m_region = (m_region + 1) % STREAM_FRAMES;
+    m_used = 0;
+    m_flushed = 0;
+
+    GLsync &fence = m_fences[std::size_t(m_region)];
+    if (fence)
+    {
+        // Poll first, so only real waits count as stalls
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            auto start = std::chrono::steady_clock::now();
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+            {
+            }
+            ++m_stats.stalls;
+            m_stats.stallMillis += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    if (!m_mapped && m_region == 0)
+    {
+        // Orphan once per trip around the ring: the driver detaches the storage the GPU may still read
+        glBindBuffer(m_target, m_buffer);
+        glBufferData(m_target, GLsizeiptr(m_regionBytes * STREAM_FRAMES), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(m_target, 0);
+    }
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::size_t start = (m_used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes > m_regionBytes)
+        return {};
+    m_used = start + bytes;
+
+    Allocation allocation;
+    allocation.offset = GLintptr(std::size_t(m_region) * m_regionBytes + start);
+    allocation.data = m_mapped ? m_mapped + allocation.offset : m_staging.data() + start;
+    return allocation;
+}
+
+void StreamBuffer::flush()
+{
+    if (m_mapped || m_flushed == m_used)
+        return;
+    glBindBuffer(m_target, m_buffer);
+    glBufferSubData(m_target, GLintptr(std::size_t(m_region) * m_regionBytes + m_flushed), GLsizeiptr(m_used - m_flushed),
+                    m_staging.data() + m_flushed);
+    glBindBuffer(m_target, 0);
+    m_flushed = m_used;
+}
+
+void StreamBuffer::endFrame()
+{
+    flush();
+    if (m_mapped) // The fallback writes each region once per orphaned storage, it never needs to wait
+        m_fences[std::size_t(m_region)] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++m_stats.frames;
+    m_stats.bytesLastFrame = m_used;
+}
@@ -0,0 +1,81 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <glad/glad.h> // For OpenGL types and functions
+
+#include <array>   // For the per-region fences
+#include <cstddef> // For std::size_t
+#include <cstdint> // For std::uint64_t counters
+#include <vector>  // For the fallback staging memory
+
+// Ring buffer for data written once per frame and read by the GPU in that frame (draw commands, uniform
+// blocks, dynamic vertices). The buffer is split into STREAM_FRAMES regions used in turn, so the CPU
+// writes frame N while the GPU may still read frames N-1 and N-2. A fence per region, inserted at
+// endFrame(), tells beginFrame() when a region is free again; with three regions that wait normally
+// finds the fence long signalled and never blocks.
+//
+// With GL 4.4 / ARB_buffer_storage the buffer is mapped once, persistent and coherent, and allocate()
+// returns pointers straight into it. On plain 3.3 allocate() returns staging memory instead; flush()
+// copies it in with glBufferSubData and beginFrame() orphans the buffer (glBufferData with no data) each
+// time the ring wraps, so the driver hands out fresh storage instead of waiting for the GPU, and no fences
+// are needed.
+constexpr int STREAM_FRAMES = 3;
+
+class StreamBuffer
+{
+public:
+    // Needs a current context. loader is used to load glBufferStorage, which the 3.3 loader lacks; without
+    // it (or with persistent false) the fallback is used.
+    StreamBuffer(GLenum target, std::size_t bytesPerFrame, GLADloadproc loader = nullptr, bool persistent = true);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer &) = delete;
+    StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+    struct Allocation
+    {
+        void *data = nullptr; // Write here, nullptr if the frame's region is full
+        GLintptr offset = 0;  // Where the GPU sees it in buffer()
+    };
+
+    // Waits (if it must) until the GPU is done with the region this frame writes to
+    void beginFrame();
+    // alignment must be a power of two (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform blocks)
+    Allocation allocate(std::size_t bytes, std::size_t alignment = 16);
+    // Makes everything allocated so far visible to the GPU; call before the draws that read it
+    void flush();
+    // Fences the region; nothing may be allocated until the next beginFrame()
+    void endFrame();
+
+    GLuint buffer() const { return m_buffer; }
+    GLenum target() const { return m_target; }
+    bool persistent() const { return m_mapped != nullptr; }
+    std::size_t bytesPerFrame() const { return m_regionBytes; }
+
+    struct Stats
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t stalls = 0; // beginFrame() calls that had to wait for the GPU
+        double stallMillis = 0.0; // Time spent waiting in them
+        std::size_t bytesLastFrame = 0;
+    };
+    const Stats &stats() const { return m_stats; }
+
+private:
+    using BufferStorageProc = void(APIENTRYP)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+
+    GLenum m_target;
+    GLuint m_buffer = 0;
+    std::size_t m_regionBytes;
+    int m_region = 0;          // Region of the current frame
+    std::size_t m_used = 0;    // Bytes allocated in it
+    std::size_t m_flushed = 0; // Fallback: bytes of it already copied to the buffer
+    std::array<GLsync, STREAM_FRAMES> m_fences{};
+
+    std::uint8_t *m_mapped = nullptr;    // Persistent mapping of the whole buffer
+    std::vector<std::uint8_t> m_staging; // Fallback: this frame's data until flush()
+
+    Stats m_stats;
+};
+
+#endif
@@ -3,18 +3,31 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
+
+#include "core/vecmath.h"
+#include "render/program_cache.h"
+
+// Pre-resolved uniform location for hot paths; look it up once with Shader::uniform() and keep it.
+// A default (or unknown) handle has location -1, which OpenGL silently ignores.
+struct UniformHandle
+{
+    GLint location = -1;
+    bool valid() const { return location >= 0; }
+};
 
 class Shader
 {
 public:
     unsigned int ID;
-    // constructor generates the shader on the fly
+    // constructor generates the shader on the fly, or loads the linked program from cache when given one
     // ------------------------------------------------------------------------
-    Shader(const char *vertexPath, const char *fragmentPath)
+    Shader(const char *vertexPath, const char *fragmentPath, const ProgramCache *cache = nullptr)
     {
         // 1. retrieve the vertex/fragment source code from filePath
         std::string vertexCode;
@@ -44,9 +57,22 @@ public:
         {
             std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
         }
+        // 2. reuse the program binary from an earlier run if the sources and driver are unchanged
+        std::uint64_t cacheKey = 0;
+        if (cache && cache->available())
+        {
+            cacheKey = cache->key(vertexCode, fragmentCode);
+            ID = cache->load(cacheKey);
+            if (ID)
+            {
+                m_fromCache = true;
+                reflectUniforms();
+                return;
+            }
+        }
         const char *vShaderCode = vertexCode.c_str();
         const char *fShaderCode = fragmentCode.c_str();
-        // 2. compile shaders
+        // 3. compile shaders
         unsigned int vertex, fragment;
         // vertex shader
         vertex = glCreateShader(GL_VERTEX_SHADER);
@@ -62,36 +88,137 @@ public:
         ID = glCreateProgram();
         glAttachShader(ID, vertex);
         glAttachShader(ID, fragment);
+        if (cache)
+            cache->prepare(ID);
         glLinkProgram(ID);
         checkCompileErrors(ID, "PROGRAM");
         // delete the shaders as they're linked into our program now and no longer necessary
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+        // 4. save the linked program for the next launch
+        GLint linked = GL_FALSE;
+        glGetProgramiv(ID, GL_LINK_STATUS, &linked);
+        if (cache && linked)
+            cache->store(cacheKey, ID);
+        // 5. look up every active uniform once, so setters never ask the driver again
+        reflectUniforms();
     }
+    // true if the program came from the binary cache instead of being compiled
+    // ------------------------------------------------------------------------
+    bool fromCache() const { return m_fromCache; }
     // activate the shader
     // ------------------------------------------------------------------------
     void use()
     {
         glUseProgram(ID);
     }
-    // utility uniform functions
+    // uniform lookup
+    // ------------------------------------------------------------------------
+    // Handle of an active uniform (array uniforms by their plain name, e.g. "lights"); invalid if the
+    // program has no such uniform or the compiler removed it
+    UniformHandle uniform(const std::string &name) const
+    {
+        auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name,
+                                   [](const UniformInfo &info, const std::string &key) { return info.name < key; });
+        if (it == m_uniforms.end() || it->name != name)
+            return {};
+        return {it->location};
+    }
+    // ------------------------------------------------------------------------
+    struct UniformInfo
+    {
+        std::string name;
+        GLint location = -1;
+        GLenum type = 0; // GL_FLOAT_MAT4, GL_SAMPLER_2D, ...
+        GLint size = 0;  // Array length, 1 for plain uniforms
+    };
+    // Active uniforms sorted by name
+    const std::vector<UniformInfo> &uniforms() const { return m_uniforms; }
+
+    // utility uniform functions (the program must be in use)
+    // ------------------------------------------------------------------------
+    void setBool(const std::string &name, bool value) const { setBool(uniform(name), value); }
+    void setBool(UniformHandle handle, bool value) const
+    {
+        glUniform1i(handle.location, (int)value);
+    }
+    // ------------------------------------------------------------------------
+    void setInt(const std::string &name, int value) const { setInt(uniform(name), value); }
+    void setInt(UniformHandle handle, int value) const
+    {
+        glUniform1i(handle.location, value);
+    }
+    // ------------------------------------------------------------------------
+    void setFloat(const std::string &name, float value) const { setFloat(uniform(name), value); }
+    void setFloat(UniformHandle handle, float value) const
+    {
+        glUniform1f(handle.location, value);
+    }
     // ------------------------------------------------------------------------
-    void setBool(const std::string &name, bool value) const
+    void setVec2(const std::string &name, float x, float y) const { setVec2(uniform(name), x, y); }
+    void setVec2(UniformHandle handle, float x, float y) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        glUniform2f(handle.location, x, y);
     }
     // ------------------------------------------------------------------------
-    void setInt(const std::string &name, int value) const
+    void setVec3(const std::string &name, const Vec3 &value) const { setVec3(uniform(name), value); }
+    void setVec3(UniformHandle handle, const Vec3 &value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform3f(handle.location, value.x, value.y, value.z);
     }
     // ------------------------------------------------------------------------
-    void setFloat(const std::string &name, float value) const
+    void setVec4(const std::string &name, float x, float y, float z, float w) const { setVec4(uniform(name), x, y, z, w); }
+    void setVec4(UniformHandle handle, float x, float y, float z, float w) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform4f(handle.location, x, y, z, w);
     }
+    // ------------------------------------------------------------------------
+    // values points at count * 4 floats, for a vec4 array uniform
+    void setVec4Array(const std::string &name, const float *values, int count) const { setVec4Array(uniform(name), values, count); }
+    void setVec4Array(UniformHandle handle, const float *values, int count) const
+    {
+        glUniform4fv(handle.location, count, values);
+    }
+    // ------------------------------------------------------------------------
+    void setMat4(const std::string &name, const float *value) const { setMat4(uniform(name), value); }
+    void setMat4(UniformHandle handle, const float *value) const
+    {
+        // value points at 16 floats in column-major order
+        glUniformMatrix4fv(handle.location, 1, GL_FALSE, value);
+    }
+    void setMat4(const std::string &name, const Mat4 &value) const { setMat4(uniform(name), value.data()); }
+    void setMat4(UniformHandle handle, const Mat4 &value) const { setMat4(handle, value.data()); }
 
 private:
+    std::vector<UniformInfo> m_uniforms;
+    bool m_fromCache = false;
+
+    // fills m_uniforms from the linked program
+    // ------------------------------------------------------------------------
+    void reflectUniforms()
+    {
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+        std::vector<char> buffer(std::size_t(std::max(maxLength, 1)));
+        for (GLint i = 0; i < count; ++i)
+        {
+            UniformInfo info;
+            GLsizei length = 0;
+            glGetActiveUniform(ID, GLuint(i), GLsizei(buffer.size()), &length, &info.size, &info.type, buffer.data());
+            info.name.assign(buffer.data(), std::size_t(length));
+            // Arrays are reported as "name[0]"; their location is also the location of the plain name
+            if (info.name.size() > 3 && info.name.compare(info.name.size() - 3, 3, "[0]") == 0)
+                info.name.resize(info.name.size() - 3);
+            info.location = glGetUniformLocation(ID, info.name.c_str());
+            if (info.location >= 0) // Uniforms in uniform blocks have no location
+                m_uniforms.push_back(std::move(info));
+        }
+        std::sort(m_uniforms.begin(), m_uniforms.end(),
+                  [](const UniformInfo &a, const UniformInfo &b) { return a.name < b.name; });
+    }
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
     void checkCompileErrors(unsigned int shader, std::string type)
@@ -1,5 +1,10 @@
+// Only the formats the game ships, and no FILE-based loading: every image is read into memory first
+// and decoded with stbi_load_from_memory, on the job system when there are many (texture/image_decoder.h)
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_PNG
+#define STBI_NO_STDIO
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 // int width, height, nrChannels;
-// unsigned char *data = stbi_load("../images/texture.jpg", &width, &height, &nrChannels, 0);
\ No newline at end of file
+// unsigned char *data = stbi_load("../images/texture.jpg", &width, &height, &nrChannels, 0);
@@ -0,0 +1,89 @@
+#include "storage/chunk_saver.h"
+
+#include <utility> // For std::move
+
+ChunkSaver::ChunkSaver(RegionStorage &storage) : m_storage(storage), m_thread([this] { run(); })
+{
+}
+
+ChunkSaver::~ChunkSaver()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void ChunkSaver::save(const Chunk &chunk)
+{
+    Pending pending;
+    pending.pos = chunk.position();
+    chunk.serialize(pending.data);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(pending));
+    }
+    m_wake.notify_one();
+}
+
+void ChunkSaver::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_syncRequested = true;
+    m_wake.notify_one();
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_writing && !m_syncRequested; });
+}
+
+std::size_t ChunkSaver::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + (m_writing ? 1 : 0);
+}
+
+std::size_t ChunkSaver::failures() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failures;
+}
+
+void ChunkSaver::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this] { return m_stopping || m_syncRequested || !m_queue.empty(); });
+
+        if (!m_queue.empty())
+        {
+            Pending pending = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_writing = true;
+            lock.unlock();
+            bool ok = m_storage.save(pending.pos, pending.data);
+            lock.lock();
+            m_writing = false;
+            if (!ok)
+                ++m_failures;
+            continue;
+        }
+
+        // Header entries are only synced once the queue is drained, one fdatasync per burst instead of per chunk
+        if (m_syncRequested)
+        {
+            m_writing = true;
+            lock.unlock();
+            m_storage.sync();
+            lock.lock();
+            m_writing = false;
+            m_syncRequested = false;
+            m_idle.notify_all();
+            continue;
+        }
+
+        if (m_stopping)
+            return;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef CHUNK_SAVER_H
+#define CHUNK_SAVER_H
+
+#include <condition_variable> // For waking the save thread and waiting in flush()
+#include <cstddef>            // For std::size_t
+#include <deque>              // For the save queue
+#include <mutex>              // For the queue lock
+#include <thread>             // For the save thread
+#include <vector>             // For serialized chunk buffers
+
+#include "storage/region_storage.h"
+
+// Writes chunks on a dedicated thread so autosave never stalls the render loop.
+// The caller (the thread that owns the world) only serializes the chunk, which is a few memcpys;
+// compression and file I/O happen on the save thread. Blocking disk I/O is kept off the job system
+// so it cannot hold up meshing or generation.
+class ChunkSaver
+{
+public:
+    explicit ChunkSaver(RegionStorage &storage);
+    ~ChunkSaver(); // Writes everything still queued
+
+    ChunkSaver(const ChunkSaver &) = delete;
+    ChunkSaver &operator=(const ChunkSaver &) = delete;
+
+    // Snapshots the chunk and queues it for writing
+    void save(const Chunk &chunk);
+
+    // Blocks until everything queued so far is written and synced to disk
+    void flush();
+
+    std::size_t pending() const;
+    std::size_t failures() const;
+
+private:
+    struct Pending
+    {
+        ChunkPos pos;
+        std::vector<std::uint8_t> data;
+    };
+
+    void run();
+
+    RegionStorage &m_storage;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake; // Work arrived or stopping
+    std::condition_variable m_idle; // Queue drained and synced
+    std::deque<Pending> m_queue;
+    bool m_writing = false;         // The thread holds a popped chunk or is syncing
+    bool m_syncRequested = false;
+    bool m_stopping = false;
+    std::size_t m_failures = 0;
+    std::thread m_thread;           // Last, so it starts after everything above is initialised
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "storage/region_file.h"
+
+#include <algorithm> // For std::max
+#include <cstring>   // For std::memcpy
+
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <sys/uio.h>  // For pwritev
+#include <unistd.h>   // For pread, pwrite, fdatasync, close
+
+namespace
+{
+    constexpr std::size_t MIN_MAP_BYTES = 1 << 20; // Grow the mapping in big steps, not once per appended chunk
+
+    // Writes everything or fails; pwritev may write partially
+    bool writeFully(int fd, iovec *parts, int count, off_t offset)
+    {
+        while (count > 0)
+        {
+            ssize_t written = pwritev(fd, parts, count, offset);
+            if (written < 0)
+                return false;
+            offset += written;
+            while (count > 0 && std::size_t(written) >= parts->iov_len)
+            {
+                written -= ssize_t(parts->iov_len);
+                ++parts;
+                --count;
+            }
+            if (count > 0)
+            {
+                parts->iov_base = static_cast<std::uint8_t *>(parts->iov_base) + written;
+                parts->iov_len -= std::size_t(written);
+            }
+        }
+        return true;
+    }
+}
+
+bool RegionFile::open(const std::string &path, bool create)
+{
+    close();
+    m_fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+    if (m_fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(m_fd, &info) != 0)
+    {
+        close();
+        return false;
+    }
+
+    // A torn append can leave a partial sector at the end; it is unreferenced, the next append overwrites it
+    m_fileSize = std::size_t(info.st_size) / REGION_SECTOR_BYTES * REGION_SECTOR_BYTES;
+    m_header.fill({});
+    if (m_fileSize == 0)
+    {
+        iovec header = {m_header.data(), HEADER_BYTES};
+        if (!writeFully(m_fd, &header, 1, 0))
+        {
+            close();
+            return false;
+        }
+        m_fileSize = HEADER_BYTES;
+    }
+    else if (m_fileSize < HEADER_BYTES || pread(m_fd, m_header.data(), HEADER_BYTES, 0) != ssize_t(HEADER_BYTES))
+    {
+        close();
+        return false;
+    }
+
+    if (!mapAtLeast(m_fileSize))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RegionFile::close()
+{
+    if (m_map)
+        munmap(m_map, m_mapSize);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_map = nullptr;
+    m_mapSize = 0;
+    m_fileSize = 0;
+    m_fd = -1;
+}
+
+bool RegionFile::mapAtLeast(std::size_t bytes)
+{
+    if (bytes <= m_mapSize)
+        return true;
+
+    std::size_t size = std::max({bytes, m_mapSize * 2, MIN_MAP_BYTES});
+    void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+    if (m_map)
+        munmap(m_map, m_mapSize);
+    m_map = static_cast<std::uint8_t *>(map);
+    m_mapSize = size;
+    return true;
+}
+
+bool RegionFile::read(int localX, int localZ, Payload &payload) const
+{
+    const Entry &entry = m_header[entryIndex(localX, localZ)];
+    if (entry.sectorCount == 0)
+        return false;
+
+    std::size_t start = std::size_t(entry.firstSector) * REGION_SECTOR_BYTES;
+    std::size_t capacity = std::size_t(entry.sectorCount) * REGION_SECTOR_BYTES;
+    if (start < HEADER_BYTES || start + capacity > m_fileSize)
+        return false;
+
+    std::uint32_t sizes[2];
+    std::memcpy(sizes, m_map + start, sizeof(sizes));
+    if (sizes[1] > capacity - PAYLOAD_PREFIX)
+        return false;
+
+    payload.data = m_map + start + PAYLOAD_PREFIX;
+    payload.size = sizes[1];
+    payload.uncompressedSize = sizes[0];
+    return true;
+}
+
+bool RegionFile::write(int localX, int localZ, const std::uint8_t *compressed, std::size_t size, std::uint32_t uncompressedSize)
+{
+    static const std::uint8_t padding[REGION_SECTOR_BYTES] = {};
+
+    std::size_t sectors = (PAYLOAD_PREFIX + size + REGION_SECTOR_BYTES - 1) / REGION_SECTOR_BYTES;
+    std::uint32_t sizes[2] = {uncompressedSize, std::uint32_t(size)};
+    iovec parts[3] = {
+        {sizes, PAYLOAD_PREFIX},
+        {const_cast<std::uint8_t *>(compressed), size},
+        {const_cast<std::uint8_t *>(padding), sectors * REGION_SECTOR_BYTES - PAYLOAD_PREFIX - size},
+    };
+    if (!writeFully(m_fd, parts, 3, off_t(m_fileSize)))
+        return false;
+
+    // Only repoint the header once the payload is completely in the file and on the disk; without the barrier
+    // the kernel may write the header back first, and power loss then leaves it pointing at garbage
+    if (fdatasync(m_fd) != 0)
+        return false;
+    Entry entry = {std::uint32_t(m_fileSize / REGION_SECTOR_BYTES), std::uint32_t(sectors)};
+    int index = entryIndex(localX, localZ);
+    if (pwrite(m_fd, &entry, sizeof(entry), off_t(index * sizeof(Entry))) != ssize_t(sizeof(entry)))
+        return false;
+
+    m_header[index] = entry;
+    m_fileSize += sectors * REGION_SECTOR_BYTES;
+    return mapAtLeast(m_fileSize);
+}
+
+bool RegionFile::sync()
+{
+    return m_fd >= 0 && fdatasync(m_fd) == 0;
+}
+
+std::size_t RegionFile::wastedSectors() const
+{
+    std::size_t used = HEADER_BYTES / REGION_SECTOR_BYTES;
+    for (const Entry &entry : m_header)
+        used += entry.sectorCount;
+    return m_fileSize / REGION_SECTOR_BYTES - used;
+}
@@ -0,0 +1,77 @@
+#ifndef REGION_FILE_H
+#define REGION_FILE_H
+
+#include <array>   // For the header table
+#include <cstddef> // For std::size_t
+#include <cstdint> // For fixed-width integer types
+#include <string>  // For file paths
+
+// A region file stores the chunks of one 32x32 chunk area.
+//
+// Layout (all sizes little-endian):
+//   header    REGION_CHUNKS entries of {u32 first sector, u32 sector count}, 0/0 = chunk not stored
+//   payloads  sector aligned: {u32 uncompressed size, u32 compressed size, compressed bytes}, zero padded
+//
+// The file is memory mapped for reads, so loading a chunk decompresses straight out of the page cache.
+// Writes always append the new payload, sync it and only then repoint the header entry, so a crash or power
+// loss mid-save leaves the previous version readable. The new header entry itself is durable after sync().
+// The space of replaced payloads is not reclaimed (see wastedSectors()).
+//
+// Not thread-safe: RegionStorage serialises access to each file.
+constexpr int REGION_SIZE = 32; // Chunks along x and z
+constexpr int REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+constexpr std::size_t REGION_SECTOR_BYTES = 4096;
+
+class RegionFile
+{
+public:
+    RegionFile() = default;
+    ~RegionFile() { close(); }
+
+    RegionFile(const RegionFile &) = delete;
+    RegionFile &operator=(const RegionFile &) = delete;
+
+    // Opens (or with create, creates) the file and maps it; false if it cannot be opened or is damaged
+    bool open(const std::string &path, bool create);
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+
+    // Compressed payload of a chunk inside the mapping; only valid until the next write
+    struct Payload
+    {
+        const std::uint8_t *data = nullptr;
+        std::size_t size = 0;
+        std::uint32_t uncompressedSize = 0;
+    };
+    // localX and localZ are in [0, REGION_SIZE); false if the chunk was never written or its entry is invalid
+    bool read(int localX, int localZ, Payload &payload) const;
+    bool contains(int localX, int localZ) const { return m_header[entryIndex(localX, localZ)].sectorCount != 0; }
+
+    bool write(int localX, int localZ, const std::uint8_t *compressed, std::size_t size, std::uint32_t uncompressedSize);
+
+    // Pushes written data to the disk (fdatasync)
+    bool sync();
+
+    std::size_t fileSize() const { return m_fileSize; }
+    std::size_t wastedSectors() const; // Sectors only referenced by replaced payloads
+
+private:
+    struct Entry
+    {
+        std::uint32_t firstSector = 0;
+        std::uint32_t sectorCount = 0;
+    };
+    static constexpr std::size_t HEADER_BYTES = REGION_CHUNKS * sizeof(Entry);
+    static constexpr std::size_t PAYLOAD_PREFIX = 2 * sizeof(std::uint32_t);
+
+    static int entryIndex(int localX, int localZ) { return localZ * REGION_SIZE + localX; }
+    bool mapAtLeast(std::size_t bytes);
+
+    int m_fd = -1;
+    std::uint8_t *m_map = nullptr;
+    std::size_t m_mapSize = 0;  // Mapped bytes; may run past the end of the file, those pages are never touched
+    std::size_t m_fileSize = 0; // Always a multiple of REGION_SECTOR_BYTES
+    std::array<Entry, REGION_CHUNKS> m_header{};
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "storage/region_storage.h"
+
+#include <filesystem> // For creating the save directory
+#include <utility>    // For std::move
+
+#include <zlib.h> // For compress2, uncompress
+
+#include "core/vecmath.h" // For floorDiv, floorMod
+
+RegionStorage::RegionStorage(std::string directory, int compressionLevel)
+    : m_directory(std::move(directory)), m_compressionLevel(compressionLevel)
+{
+}
+
+ChunkPos RegionStorage::regionFor(ChunkPos chunk)
+{
+    return {floorDiv(chunk.x, REGION_SIZE), floorDiv(chunk.z, REGION_SIZE)};
+}
+
+std::string RegionStorage::regionPath(ChunkPos region) const
+{
+    return m_directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.z) + ".region";
+}
+
+RegionStorage::Region *RegionStorage::region(ChunkPos regionPos, bool create)
+{
+    // The table lock only covers the lookup: regions are never removed, so the pointer stays valid without it,
+    // and waiting for a file lock under it would stall every other region behind one slow reader
+    Region *slot;
+    {
+        std::lock_guard<std::mutex> lock(m_regionsMutex);
+        std::unique_ptr<Region> &entry = m_regions[regionPos];
+        if (!entry)
+            entry = std::make_unique<Region>();
+        slot = entry.get();
+    }
+
+    // Files are opened once, so almost every call only needs to see that it is open
+    {
+        std::shared_lock<std::shared_mutex> fileLock(slot->mutex);
+        if (slot->file.isOpen())
+            return slot;
+    }
+    std::unique_lock<std::shared_mutex> fileLock(slot->mutex);
+    if (slot->file.isOpen())
+        return slot; // Opened by another thread in the meantime
+
+    std::string path = regionPath(regionPos);
+    std::error_code error;
+    if (!create && !std::filesystem::exists(path, error))
+        return nullptr;
+    if (create)
+        std::filesystem::create_directories(m_directory, error);
+    return slot->file.open(path, create) ? slot : nullptr;
+}
+
+std::unique_ptr<Chunk> RegionStorage::load(ChunkPos pos)
+{
+    Region *r = region(regionFor(pos), false);
+    if (!r)
+        return nullptr;
+
+    std::vector<std::uint8_t> data;
+    {
+        // Decompress straight out of the mapping; writers to this region wait meanwhile
+        std::shared_lock<std::shared_mutex> lock(r->mutex);
+        RegionFile::Payload payload;
+        if (!r->file.read(floorMod(pos.x, REGION_SIZE), floorMod(pos.z, REGION_SIZE), payload))
+            return nullptr;
+
+        // The size comes straight from the file; a corrupt one must not turn into a huge allocation
+        if (payload.uncompressedSize > Chunk::MAX_SERIALIZED_SIZE)
+            return nullptr;
+        data.resize(payload.uncompressedSize);
+        uLongf size = uLongf(data.size());
+        if (uncompress(data.data(), &size, payload.data, uLong(payload.size)) != Z_OK || size != data.size())
+            return nullptr;
+    }
+    return Chunk::deserialize(pos, data.data(), data.size());
+}
+
+bool RegionStorage::save(const Chunk &chunk)
+{
+    std::vector<std::uint8_t> data;
+    chunk.serialize(data);
+    return save(chunk.position(), data);
+}
+
+bool RegionStorage::save(ChunkPos pos, const std::vector<std::uint8_t> &serialized)
+{
+    // Compress before taking any lock, it is by far the most expensive part
+    std::vector<std::uint8_t> compressed(compressBound(uLong(serialized.size())));
+    uLongf size = uLongf(compressed.size());
+    if (compress2(compressed.data(), &size, serialized.data(), uLong(serialized.size()), m_compressionLevel) != Z_OK)
+        return false;
+
+    Region *r = region(regionFor(pos), true);
+    if (!r)
+        return false;
+
+    std::unique_lock<std::shared_mutex> lock(r->mutex);
+    if (!r->file.write(floorMod(pos.x, REGION_SIZE), floorMod(pos.z, REGION_SIZE), compressed.data(), size,
+                       std::uint32_t(serialized.size())))
+        return false;
+
+    m_chunksWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+bool RegionStorage::sync()
+{
+    std::vector<Region *> regions;
+    {
+        std::lock_guard<std::mutex> lock(m_regionsMutex);
+        regions.reserve(m_regions.size());
+        for (auto &[pos, r] : m_regions)
+            regions.push_back(r.get());
+    }
+
+    bool ok = true;
+    for (Region *r : regions)
+    {
+        std::unique_lock<std::shared_mutex> fileLock(r->mutex);
+        if (r->file.isOpen())
+            ok = r->file.sync() && ok;
+    }
+    return ok;
+}
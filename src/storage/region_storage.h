@@ -0,0 +1,60 @@
+#ifndef REGION_STORAGE_H
+#define REGION_STORAGE_H
+
+#include <atomic>        // For the write counters
+#include <cstdint>       // For std::uint8_t, std::uint64_t
+#include <memory>        // For std::unique_ptr
+#include <mutex>         // For the region table lock
+#include <shared_mutex>  // For concurrent reads of one region file
+#include <string>        // For the save directory
+#include <unordered_map> // For the open region files
+#include <vector>        // For serialized chunk buffers
+
+#include "storage/region_file.h"
+#include "world/chunk.h"
+
+// Loads and saves chunks in a directory of region files (r.<x>.<z>.region, one per 32x32 chunks),
+// compressing each chunk with zlib. Safe to call from several threads at once: loads of the same region
+// run in parallel, a save locks only the region it writes to. Region files are opened on first use
+// and stay open.
+class RegionStorage
+{
+public:
+    explicit RegionStorage(std::string directory, int compressionLevel = 1);
+
+    // nullptr if the chunk was never saved (or its data is damaged)
+    std::unique_ptr<Chunk> load(ChunkPos pos);
+
+    // Compresses and writes a chunk produced by Chunk::serialize; false on I/O errors
+    bool save(ChunkPos pos, const std::vector<std::uint8_t> &serialized);
+    bool save(const Chunk &chunk);
+
+    // Flushes every open region file to the disk
+    bool sync();
+
+    const std::string &directory() const { return m_directory; }
+    std::uint64_t chunksWritten() const { return m_chunksWritten.load(std::memory_order_relaxed); }
+    std::uint64_t bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); } // Compressed
+
+    static ChunkPos regionFor(ChunkPos chunk);
+    std::string regionPath(ChunkPos region) const;
+
+private:
+    struct Region
+    {
+        RegionFile file;
+        std::shared_mutex mutex; // Shared for reads through the mapping, exclusive for writes
+    };
+
+    // nullptr if the file does not exist and create is false, or cannot be opened
+    Region *region(ChunkPos regionPos, bool create);
+
+    std::string m_directory;
+    int m_compressionLevel;
+    std::mutex m_regionsMutex;
+    std::unordered_map<ChunkPos, std::unique_ptr<Region>, ChunkPosHash> m_regions; // Keyed by region coordinates
+    std::atomic<std::uint64_t> m_chunksWritten{0};
+    std::atomic<std::uint64_t> m_bytesWritten{0};
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include "texture/baked_texture.h"
+
+#include <algorithm>  // For std::max
+#include <cstring>    // For std::memcpy
+#include <filesystem> // For creating the output directory and atomic replacement
+#include <fstream>    // For writing the container
+#include <limits>     // For std::numeric_limits
+
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+
+#include "texture/block_compression.h"
+
+namespace
+{
+    constexpr std::uint32_t MAGIC = 0x58544353; // "SCTX"
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t LEVEL_ALIGNMENT = 16;
+
+    struct Header
+    {
+        std::uint32_t magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint32_t format = 0;
+        std::uint32_t size = 0;
+        std::uint32_t layers = 0;
+        std::uint32_t mipCount = 0;
+        std::uint32_t nameBytes = 0;
+        std::uint32_t reserved = 0;
+    };
+
+    struct LevelEntry
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    int mipCountFor(int size)
+    {
+        int count = 1;
+        while (size > 1)
+        {
+            size /= 2;
+            ++count;
+        }
+        return count;
+    }
+
+    // Halves every layer with a 2x2 box filter
+    std::vector<std::uint8_t> downsample(const std::vector<std::uint8_t> &pixels, int size, int layers)
+    {
+        int half = size / 2;
+        std::vector<std::uint8_t> result(std::size_t(half) * std::size_t(half) * 4 * std::size_t(layers));
+        for (int layer = 0; layer < layers; ++layer)
+        {
+            const std::uint8_t *from = &pixels[std::size_t(layer) * std::size_t(size) * std::size_t(size) * 4];
+            std::uint8_t *to = &result[std::size_t(layer) * std::size_t(half) * std::size_t(half) * 4];
+            for (int y = 0; y < half; ++y)
+                for (int x = 0; x < half; ++x)
+                {
+                    const std::uint8_t *top = &from[(std::size_t(2 * y) * std::size_t(size) + std::size_t(2 * x)) * 4];
+                    const std::uint8_t *bottom = top + std::size_t(size) * 4;
+                    for (int c = 0; c < 4; ++c)
+                        to[(std::size_t(y) * std::size_t(half) + std::size_t(x)) * 4 + c] =
+                            std::uint8_t((top[c] + top[4 + c] + bottom[c] + bottom[4 + c] + 2) / 4);
+                }
+        }
+        return result;
+    }
+
+    std::vector<std::uint8_t> encodeLevel(const std::vector<std::uint8_t> &pixels, int size, int layers, BakedFormat format)
+    {
+        if (format == BakedFormat::RGBA8)
+            return pixels;
+
+        std::size_t blockBytes = format == BakedFormat::BC1 ? BC1_BLOCK_BYTES : BC3_BLOCK_BYTES;
+        std::size_t layerBytes = compressedImageBytes(size, size, blockBytes);
+        std::vector<std::uint8_t> result(layerBytes * std::size_t(layers));
+        for (int layer = 0; layer < layers; ++layer)
+        {
+            const std::uint8_t *from = &pixels[std::size_t(layer) * std::size_t(size) * std::size_t(size) * 4];
+            if (format == BakedFormat::BC1)
+                compressImageBC1(from, size, size, &result[std::size_t(layer) * layerBytes]);
+            else
+                compressImageBC3(from, size, size, &result[std::size_t(layer) * layerBytes]);
+        }
+        return result;
+    }
+}
+
+const char *bakedFormatName(BakedFormat format)
+{
+    switch (format)
+    {
+    case BakedFormat::RGBA8:
+        return "rgba8";
+    case BakedFormat::BC1:
+        return "bc1";
+    case BakedFormat::BC3:
+        return "bc3";
+    }
+    return "unknown";
+}
+
+bool parseBakedFormat(const std::string &name, BakedFormat &format)
+{
+    for (BakedFormat candidate : {BakedFormat::RGBA8, BakedFormat::BC1, BakedFormat::BC3})
+        if (name == bakedFormatName(candidate))
+        {
+            format = candidate;
+            return true;
+        }
+    return false;
+}
+
+std::size_t bakedLevelBytes(BakedFormat format, int size, int layers)
+{
+    switch (format)
+    {
+    case BakedFormat::BC1:
+        return compressedImageBytes(size, size, BC1_BLOCK_BYTES) * std::size_t(layers);
+    case BakedFormat::BC3:
+        return compressedImageBytes(size, size, BC3_BLOCK_BYTES) * std::size_t(layers);
+    default:
+        return std::size_t(size) * std::size_t(size) * 4 * std::size_t(layers);
+    }
+}
+
+std::vector<std::vector<std::uint8_t>> buildMipChain(const TextureLayers &layers)
+{
+    std::vector<std::vector<std::uint8_t>> levels;
+    if (layers.empty())
+        return levels;
+    levels.push_back(layers.pixels);
+    for (int size = layers.size; size > 1; size /= 2)
+        levels.push_back(downsample(levels.back(), size, layers.count()));
+    return levels;
+}
+
+bool writeBakedTexture(const std::string &path, const TextureLayers &layers, BakedFormat format)
+{
+    if (layers.empty() || (layers.size & (layers.size - 1)) != 0)
+        return false;
+
+    Header header;
+    header.format = std::uint32_t(format);
+    header.size = std::uint32_t(layers.size);
+    header.layers = std::uint32_t(layers.count());
+    header.mipCount = std::uint32_t(mipCountFor(layers.size));
+
+    std::string names;
+    for (const std::string &name : layers.names)
+        names += name + "\n";
+    header.nameBytes = std::uint32_t(names.size());
+
+    // Encode every level first, the table needs their sizes
+    std::vector<std::vector<std::uint8_t>> levels = buildMipChain(layers);
+    for (int mip = 0; mip < int(levels.size()); ++mip)
+        levels[std::size_t(mip)] = encodeLevel(levels[std::size_t(mip)], std::max(1, layers.size >> mip), layers.count(), format);
+
+    std::vector<LevelEntry> table(levels.size());
+    std::size_t offset = sizeof(Header) + sizeof(LevelEntry) * table.size() + names.size();
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        offset = (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+        table[i].offset = offset;
+        table[i].bytes = levels[i].size();
+        offset += levels[i].size();
+    }
+
+    // Temporary file plus rename, so the game never maps a half-written container
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path(), error);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(table.data()), std::streamsize(table.size() * sizeof(LevelEntry)));
+        file.write(names.data(), std::streamsize(names.size()));
+        for (std::size_t i = 0; i < levels.size(); ++i)
+        {
+            static const char zeros[LEVEL_ALIGNMENT] = {};
+            file.write(zeros, std::streamsize(table[i].offset - std::uint64_t(file.tellp())));
+            file.write(reinterpret_cast<const char *>(levels[i].data()), std::streamsize(levels[i].size()));
+        }
+        file.close();
+        if (!file)
+        {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+        return false;
+    }
+    return true;
+}
+
+bool BakedTexture::open(const std::string &path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || std::size_t(info.st_size) < sizeof(Header))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file alive, the descriptor is not needed any more
+    std::size_t size = std::size_t(info.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    m_map = static_cast<const std::uint8_t *>(map);
+    m_mapSize = size;
+
+    Header header;
+    std::memcpy(&header, m_map, sizeof(header));
+    std::size_t tableEnd = sizeof(Header) + sizeof(LevelEntry) * std::size_t(header.mipCount);
+    // Sizes are powers of two (each mip halves them exactly) that still fit the int the accessors return
+    if (header.magic != MAGIC || header.version != VERSION || header.format > std::uint32_t(BakedFormat::BC3) || header.size == 0 ||
+        (header.size & (header.size - 1)) != 0 || header.size > std::uint32_t(std::numeric_limits<int>::max()) || header.layers == 0 ||
+        header.mipCount != std::uint32_t(mipCountFor(int(header.size))) || tableEnd > size)
+    {
+        close();
+        return false;
+    }
+    m_format = BakedFormat(header.format);
+    m_size = int(header.size);
+    m_layers = int(header.layers);
+    m_mipCount = int(header.mipCount);
+    m_levelTable = m_map + sizeof(Header);
+
+    for (int mip = 0; mip < m_mipCount; ++mip)
+    {
+        LevelEntry entry;
+        std::memcpy(&entry, m_levelTable + sizeof(LevelEntry) * std::size_t(mip), sizeof(entry));
+        if (entry.offset > size || entry.bytes > size - entry.offset ||
+            entry.bytes != bakedLevelBytes(m_format, std::max(1, m_size >> mip), m_layers))
+        {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void BakedTexture::close()
+{
+    if (m_map)
+        munmap(const_cast<std::uint8_t *>(m_map), m_mapSize);
+    m_map = nullptr;
+    m_mapSize = 0;
+    m_size = m_layers = m_mipCount = 0;
+    m_levelTable = nullptr;
+}
+
+BakedTexture::Level BakedTexture::level(int mip) const
+{
+    if (!m_map || mip < 0 || mip >= m_mipCount)
+        return {};
+    LevelEntry entry;
+    std::memcpy(&entry, m_levelTable + sizeof(LevelEntry) * std::size_t(mip), sizeof(entry));
+    return {m_map + entry.offset, std::size_t(entry.bytes), std::max(1, m_size >> mip)};
+}
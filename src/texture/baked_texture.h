@@ -0,0 +1,82 @@
+#ifndef BAKED_TEXTURE_H
+#define BAKED_TEXTURE_H
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For fixed-width integer types
+#include <string>  // For paths and format names
+#include <vector>  // For mip chains
+
+#include "texture/texture_array.h"
+
+// GPU-ready texture array container, written at build time by tools/texture_baker.cpp so the game uploads
+// bytes straight from a file mapping instead of decoding images and generating mipmaps at every launch.
+//
+// Layout (all little-endian):
+//   header    {u32 magic "SCTX", u32 version, u32 format, u32 size, u32 layers, u32 mip count, u32 name bytes, u32 0}
+//   levels    mip count entries of {u64 offset, u64 bytes}, level 0 first
+//   names     the layer names, each terminated by '\n'
+//   data      every mip level holds all layers back to back, exactly what glTexImage3D or
+//             glCompressedTexImage3D take for a GL_TEXTURE_2D_ARRAY; each level starts 16-byte aligned
+//
+// Pixel rows are stored bottom row first, like TextureLayers.
+enum class BakedFormat : std::uint32_t
+{
+    RGBA8 = 0,
+    BC1 = 1, // S3TC DXT1, opaque, 1/8 the size of RGBA8
+    BC3 = 2, // S3TC DXT5, with alpha, 1/4 the size of RGBA8
+};
+
+const char *bakedFormatName(BakedFormat format);
+bool parseBakedFormat(const std::string &name, BakedFormat &format); // "rgba8", "bc1" or "bc3"
+
+// Bytes of one mip level of size x size pixels (rounded up to whole 4x4 blocks when compressed) for all layers
+std::size_t bakedLevelBytes(BakedFormat format, int size, int layers);
+
+// Level 0 (the layers themselves) down to 1x1, every level holding all layers, made with a 2x2 box filter.
+// The size must be a power of two.
+std::vector<std::vector<std::uint8_t>> buildMipChain(const TextureLayers &layers);
+
+// Builds the full mip chain of every layer on the CPU (2x2 box filter), compresses it if asked and writes
+// the container. The size must be a power of two. False if the file cannot be written.
+bool writeBakedTexture(const std::string &path, const TextureLayers &layers, BakedFormat format);
+
+// A baked container mapped into memory (read-only); the level pointers stay valid until close()
+class BakedTexture
+{
+public:
+    BakedTexture() = default;
+    ~BakedTexture() { close(); }
+
+    BakedTexture(const BakedTexture &) = delete;
+    BakedTexture &operator=(const BakedTexture &) = delete;
+
+    // False if the file is missing, of another version or damaged
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+
+    BakedFormat format() const { return m_format; }
+    int size() const { return m_size; }
+    int layerCount() const { return m_layers; }
+    int mipCount() const { return m_mipCount; }
+    std::size_t fileSize() const { return m_mapSize; }
+
+    struct Level
+    {
+        const std::uint8_t *data = nullptr;
+        std::size_t bytes = 0;
+        int size = 0; // Width and height in pixels
+    };
+    Level level(int mip) const;
+
+private:
+    const std::uint8_t *m_map = nullptr;
+    std::size_t m_mapSize = 0;
+    BakedFormat m_format = BakedFormat::RGBA8;
+    int m_size = 0;
+    int m_layers = 0;
+    int m_mipCount = 0;
+    const std::uint8_t *m_levelTable = nullptr;
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include "texture/block_compression.h"
+
+#include <algorithm> // For std::min, std::max, std::swap
+#include <cstdlib>   // For std::abs
+#include <cstring>   // For std::memcpy
+
+namespace
+{
+    std::uint16_t to565(const int rgb[3])
+    {
+        int r = (rgb[0] * 31 + 127) / 255;
+        int g = (rgb[1] * 63 + 127) / 255;
+        int b = (rgb[2] * 31 + 127) / 255;
+        return std::uint16_t((r << 11) | (g << 5) | b);
+    }
+
+    void from565(std::uint16_t color, int rgb[3])
+    {
+        int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    void writeLE(std::uint8_t *out, std::uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; ++i)
+            out[i] = std::uint8_t(value >> (8 * i));
+    }
+
+    // The four-colour BC1 block, also the colour half of BC3
+    void encodeColor(const std::uint8_t block[64], std::uint8_t out[8])
+    {
+        int low[3] = {255, 255, 255}, high[3] = {0, 0, 0};
+        int mean[3] = {0, 0, 0};
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 3; ++c)
+            {
+                low[c] = std::min(low[c], int(block[i * 4 + c]));
+                high[c] = std::max(high[c], int(block[i * 4 + c]));
+                mean[c] += block[i * 4 + c];
+            }
+
+        // The box diagonal runs along the channel with the widest range; a channel that falls while that one
+        // rises gets its endpoints swapped, so the line follows the colours instead of crossing them
+        int primary = 0;
+        for (int c = 1; c < 3; ++c)
+            if (high[c] - low[c] > high[primary] - low[primary])
+                primary = c;
+        for (int c = 0; c < 3; ++c)
+        {
+            if (c == primary)
+                continue;
+            int covariance = 0;
+            for (int i = 0; i < 16; ++i)
+                covariance += (block[i * 4 + primary] * 16 - mean[primary]) * (block[i * 4 + c] * 16 - mean[c]);
+            if (covariance < 0)
+                std::swap(low[c], high[c]);
+        }
+
+        // Inset the endpoints by 1/16 of the range, the outermost pixels then land near a palette entry too
+        for (int c = 0; c < 3; ++c)
+        {
+            int inset = (high[c] - low[c]) / 16;
+            high[c] -= inset;
+            low[c] += inset;
+        }
+
+        std::uint16_t color0 = to565(high), color1 = to565(low);
+        if (color0 < color1)
+            std::swap(color0, color1); // color0 > color1 selects the four-colour mode
+        std::uint32_t indices = 0;
+        if (color0 != color1)
+        {
+            int palette[4][3];
+            from565(color0, palette[0]);
+            from565(color1, palette[1]);
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = 0, bestDistance = 1 << 30;
+                for (int p = 0; p < 4; ++p)
+                {
+                    int distance = 0;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        int d = int(block[i * 4 + c]) - palette[p][c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+                indices |= std::uint32_t(best) << (2 * i);
+            }
+        }
+        writeLE(out, color0, 2);
+        writeLE(out + 2, color1, 2);
+        writeLE(out + 4, indices, 4);
+    }
+
+    // The eight-value alpha block of BC3
+    void encodeAlpha(const std::uint8_t block[64], std::uint8_t out[8])
+    {
+        int high = 0, low = 255;
+        for (int i = 0; i < 16; ++i)
+        {
+            high = std::max(high, int(block[i * 4 + 3]));
+            low = std::min(low, int(block[i * 4 + 3]));
+        }
+
+        std::uint64_t indices = 0;
+        if (high != low)
+        {
+            int palette[8] = {high, low};
+            for (int p = 2; p < 8; ++p)
+                palette[p] = ((8 - p) * high + (p - 1) * low) / 7;
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = 0, bestDistance = 256;
+                for (int p = 0; p < 8; ++p)
+                {
+                    int distance = std::abs(int(block[i * 4 + 3]) - palette[p]);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+                indices |= std::uint64_t(best) << (3 * i);
+            }
+        }
+        out[0] = std::uint8_t(high);
+        out[1] = std::uint8_t(low);
+        writeLE(out + 2, indices, 6);
+    }
+
+    template <typename Encode>
+    void compressImage(const std::uint8_t *rgba, int width, int height, std::uint8_t *out, std::size_t blockBytes, Encode encode)
+    {
+        std::uint8_t block[64];
+        for (int by = 0; by < height; by += 4)
+            for (int bx = 0; bx < width; bx += 4)
+            {
+                for (int y = 0; y < 4; ++y)
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        int sx = std::min(bx + x, width - 1), sy = std::min(by + y, height - 1);
+                        std::memcpy(&block[(y * 4 + x) * 4], &rgba[(std::size_t(sy) * std::size_t(width) + std::size_t(sx)) * 4], 4);
+                    }
+                encode(block, out);
+                out += blockBytes;
+            }
+    }
+}
+
+void encodeBC1Block(const std::uint8_t block[64], std::uint8_t out[BC1_BLOCK_BYTES])
+{
+    encodeColor(block, out);
+}
+
+void encodeBC3Block(const std::uint8_t block[64], std::uint8_t out[BC3_BLOCK_BYTES])
+{
+    encodeAlpha(block, out);
+    encodeColor(block, out + 8);
+}
+
+std::size_t compressedImageBytes(int width, int height, std::size_t blockBytes)
+{
+    return std::size_t((width + 3) / 4) * std::size_t((height + 3) / 4) * blockBytes;
+}
+
+void compressImageBC1(const std::uint8_t *rgba, int width, int height, std::uint8_t *out)
+{
+    compressImage(rgba, width, height, out, BC1_BLOCK_BYTES, encodeBC1Block);
+}
+
+void compressImageBC3(const std::uint8_t *rgba, int width, int height, std::uint8_t *out)
+{
+    compressImage(rgba, width, height, out, BC3_BLOCK_BYTES, encodeBC3Block);
+}
@@ -0,0 +1,24 @@
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For std::uint8_t
+
+// BC1 (DXT1) and BC3 (DXT5) encoders for baking textures. Quality over speed is not the goal here: they use
+// the bounding box of each 4x4 block (inset a little, with the diagonal picked from the colour covariance)
+// as endpoints, which is close to what real-time encoders do and plenty for pixel art style block textures.
+
+constexpr std::size_t BC1_BLOCK_BYTES = 8;  // Opaque RGB, 4 bits per pixel
+constexpr std::size_t BC3_BLOCK_BYTES = 16; // RGB plus interpolated alpha, 8 bits per pixel
+
+// block is 16 RGBA8 pixels, row by row
+void encodeBC1Block(const std::uint8_t block[64], std::uint8_t out[BC1_BLOCK_BYTES]);
+void encodeBC3Block(const std::uint8_t block[64], std::uint8_t out[BC3_BLOCK_BYTES]);
+
+// Compresses a whole RGBA8 image (rows in any order, they are kept as they are). Sizes that are not a
+// multiple of 4 are padded by repeating the last row and column. out needs compressedImageBytes() bytes.
+std::size_t compressedImageBytes(int width, int height, std::size_t blockBytes);
+void compressImageBC1(const std::uint8_t *rgba, int width, int height, std::uint8_t *out);
+void compressImageBC3(const std::uint8_t *rgba, int width, int height, std::uint8_t *out);
+
+#endif
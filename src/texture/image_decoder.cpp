@@ -0,0 +1,49 @@
+#include "texture/image_decoder.h"
+
+#include <fstream>  // For reading files
+#include <iterator> // For std::istreambuf_iterator
+
+#include "core/job_system.h"
+#include "stb_image.h"
+
+bool readImageFile(const std::string &path, std::vector<std::uint8_t> &bytes)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+DecodedImage decodeImage(const std::vector<std::uint8_t> &bytes)
+{
+    DecodedImage image;
+    int channels = 0;
+    // The flip flag is per thread, so workers must not rely on whatever another caller set
+    stbi_set_flip_vertically_on_load_thread(false);
+    stbi_uc *data = stbi_load_from_memory(bytes.data(), int(bytes.size()), &image.width, &image.height, &channels, 4);
+    if (!data)
+        return {};
+    image.rgba.assign(data, data + std::size_t(image.width) * std::size_t(image.height) * 4);
+    stbi_image_free(data);
+    return image;
+}
+
+std::vector<DecodedImage> decodeImages(const std::vector<const std::vector<std::uint8_t> *> &files, JobSystem *jobs)
+{
+    std::vector<DecodedImage> images(files.size());
+    if (!jobs)
+    {
+        for (std::size_t i = 0; i < files.size(); ++i)
+            images[i] = decodeImage(*files[i]);
+        return images;
+    }
+
+    // A JPEG takes milliseconds to decode, far more than scheduling a job, so one image per job
+    jobs->parallelFor(0, files.size(), 1, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+            images[i] = decodeImage(*files[i]);
+    });
+    return images;
+}
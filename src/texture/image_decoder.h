@@ -0,0 +1,31 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <cstdint> // For std::uint8_t
+#include <string>  // For file paths
+#include <vector>  // For file bytes and pixels
+
+class JobSystem;
+
+// A decoded image, always RGBA8 with the top row first
+struct DecodedImage
+{
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> rgba;
+
+    bool empty() const { return rgba.empty(); }
+};
+
+// Reads a whole file into bytes; false if it cannot be opened
+bool readImageFile(const std::string &path, std::vector<std::uint8_t> &bytes);
+
+// Decodes one encoded image (JPEG or PNG) held in memory; empty on failure
+DecodedImage decodeImage(const std::vector<std::uint8_t> &bytes);
+
+// Decodes already read files, one job per image, and waits for all of them (the calling thread helps).
+// File reading stays with the caller so the workers never block on I/O. jobs may be null to decode
+// on the calling thread. Result i belongs to files[i]; images that fail to decode come back empty.
+std::vector<DecodedImage> decodeImages(const std::vector<const std::vector<std::uint8_t> *> &files, JobSystem *jobs);
+
+#endif
@@ -0,0 +1,69 @@
+#include "texture/texture_array.h"
+
+#include <algorithm> // For std::clamp, std::min
+#include <cmath>     // For std::floor
+
+#include "core/job_system.h"
+
+namespace
+{
+    // Bilinear sample of a tile, clamped to its own rectangle so the neighbouring tiles never leak in
+    void sampleTile(const TextureAtlas &atlas, const AtlasTile &tile, float x, float y, std::uint8_t *out)
+    {
+        x = std::clamp(x, 0.0f, float(tile.width - 1));
+        y = std::clamp(y, 0.0f, float(tile.height - 1));
+        int x0 = int(std::floor(x));
+        int y0 = int(std::floor(y));
+        int x1 = std::min(x0 + 1, tile.width - 1);
+        int y1 = std::min(y0 + 1, tile.height - 1);
+        float fx = x - float(x0);
+        float fy = y - float(y0);
+
+        auto texel = [&](int tx, int ty)
+        {
+            return &atlas.pixels[(std::size_t(tile.y + ty) * std::size_t(atlas.width) + std::size_t(tile.x + tx)) * 4];
+        };
+        const std::uint8_t *a = texel(x0, y0), *b = texel(x1, y0), *c = texel(x0, y1), *d = texel(x1, y1);
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            float top = float(a[channel]) + (float(b[channel]) - float(a[channel])) * fx;
+            float bottom = float(c[channel]) + (float(d[channel]) - float(c[channel])) * fx;
+            out[channel] = std::uint8_t(top + (bottom - top) * fy + 0.5f);
+        }
+    }
+}
+
+TextureLayers layersFromAtlas(const TextureAtlas &atlas, int size, JobSystem *jobs)
+{
+    TextureLayers layers;
+    if (atlas.empty() || size <= 0)
+        return layers;
+
+    layers.size = size;
+    layers.pixels.resize(std::size_t(size) * std::size_t(size) * 4 * atlas.tiles.size());
+    for (const AtlasTile &tile : atlas.tiles)
+        layers.names.push_back(tile.name);
+
+    auto resample = [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const AtlasTile &tile = atlas.tiles[i];
+            std::uint8_t *out = layers.pixels.data() + i * std::size_t(size) * std::size_t(size) * 4;
+            float scaleX = float(tile.width) / float(size);
+            float scaleY = float(tile.height) / float(size);
+            for (int row = 0; row < size; ++row)
+            {
+                // Layer rows go bottom first, atlas rows top first
+                float y = (float(size - 1 - row) + 0.5f) * scaleY - 0.5f;
+                for (int column = 0; column < size; ++column, out += 4)
+                    sampleTile(atlas, tile, (float(column) + 0.5f) * scaleX - 0.5f, y, out);
+            }
+        }
+    };
+    if (jobs)
+        jobs->parallelFor(0, atlas.tiles.size(), 1, resample);
+    else
+        resample(0, atlas.tiles.size());
+    return layers;
+}
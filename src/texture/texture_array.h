@@ -0,0 +1,31 @@
+#ifndef TEXTURE_ARRAY_H
+#define TEXTURE_ARRAY_H
+
+#include <cstdint> // For std::uint8_t
+#include <string>  // For layer names
+#include <vector>  // For pixels and names
+
+#include "texture/texture_atlas.h"
+
+class JobSystem;
+
+// Block textures as equally sized square layers, ready for a GL_TEXTURE_2D_ARRAY: layer i is tile i, so the
+// tile index the mesher writes into each vertex selects the layer directly. Every layer stands alone, so its
+// mip chain never mixes in another tile and texture coordinates may repeat past [0, 1].
+struct TextureLayers
+{
+    int size = 0; // Width and height of every layer in pixels
+    std::vector<std::string> names;
+    std::vector<std::uint8_t> pixels; // RGBA8, layer after layer, each bottom row first (upload it as is)
+
+    bool empty() const { return pixels.empty(); }
+    int count() const { return int(names.size()); }
+    const std::uint8_t *layer(int index) const { return pixels.data() + std::size_t(index) * std::size_t(size) * std::size_t(size) * 4; }
+};
+
+// Cuts every tile back out of the atlas and resamples it (bilinear) to size x size. A power-of-two size keeps
+// every mip level an exact halving. Layers are resampled in parallel when jobs is set. Returns empty layers
+// for an empty atlas or a size <= 0.
+TextureLayers layersFromAtlas(const TextureAtlas &atlas, int size, JobSystem *jobs = nullptr);
+
+#endif
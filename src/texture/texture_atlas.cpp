@@ -0,0 +1,301 @@
+#include "texture/texture_atlas.h"
+
+#include <algorithm>     // For std::sort, std::clamp, std::max
+#include <cstdio>        // For std::snprintf
+#include <cstring>       // For std::memcpy
+#include <filesystem>    // For the cache directory
+#include <fstream>       // For the cache
+#include <unordered_map> // For decoding each source file once
+
+#include "texture/image_decoder.h"
+
+namespace
+{
+    constexpr std::uint32_t CACHE_MAGIC = 0x54414353; // "SCAT"
+    constexpr std::uint32_t CACHE_VERSION = 1;
+    constexpr int MAX_ATLAS_SIZE = 16384;
+
+    // The sheet is a 4x4 grid of 400px cells, each tile framed by a 20px black border
+    constexpr int SHEET_CELL = 400;
+    constexpr int SHEET_BORDER = 20;
+    const char *const SHEET_TILES[16] = {
+        "gold_ore", "ice", "sandstone", "dirt",                  // Row 0
+        "cobblestone", "brick", "red_sand", "sand",              // Row 1
+        "stone", "quartz", "blue_brick", "planks",               // Row 2
+        "stone_brick", "mossy_stone", "dark_dirt", "gravel",     // Row 3
+    };
+
+    std::uint64_t fnv1a(std::uint64_t hash, const void *data, std::size_t size)
+    {
+        const auto *bytes = static_cast<const std::uint8_t *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    std::uint64_t fnv1a(std::uint64_t hash, const std::string &text)
+    {
+        hash = fnv1a(hash, text.data(), text.size());
+        std::uint64_t length = text.size(); // Length as separator, so ("ab", "c") != ("a", "bc")
+        return fnv1a(hash, &length, sizeof(length));
+    }
+
+    std::string cachePath(const std::string &directory, std::uint64_t key)
+    {
+        char name[40];
+        std::snprintf(name, sizeof(name), "atlas_%016llx.bin", static_cast<unsigned long long>(key));
+        return directory + "/" + name;
+    }
+
+    void computeUVs(TextureAtlas &atlas)
+    {
+        for (AtlasTile &tile : atlas.tiles)
+        {
+            tile.u0 = float(tile.x) / float(atlas.width);
+            tile.u1 = float(tile.x + tile.width) / float(atlas.width);
+            tile.v0 = float(tile.y + tile.height) / float(atlas.height); // Bottom edge of the tile
+            tile.v1 = float(tile.y) / float(atlas.height);
+        }
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream &file, T &value)
+    {
+        return bool(file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+    }
+
+    bool loadCache(const std::string &path, std::uint64_t key, std::size_t tileCount, TextureAtlas &atlas)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::uint32_t magic = 0, version = 0, count = 0;
+        std::uint64_t storedKey = 0;
+        std::int32_t width = 0, height = 0;
+        if (!readValue(file, magic) || !readValue(file, version) || !readValue(file, storedKey) || !readValue(file, width) ||
+            !readValue(file, height) || !readValue(file, count))
+            return false;
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION || storedKey != key || count != tileCount || width <= 0 ||
+            height <= 0 || width > MAX_ATLAS_SIZE || height > MAX_ATLAS_SIZE)
+            return false;
+
+        atlas.width = width;
+        atlas.height = height;
+        atlas.tiles.resize(count);
+        for (AtlasTile &tile : atlas.tiles)
+        {
+            std::uint16_t nameLength = 0;
+            std::int32_t rect[4];
+            if (!readValue(file, nameLength))
+                return false;
+            tile.name.resize(nameLength);
+            if (!file.read(tile.name.data(), nameLength) || !readValue(file, rect))
+                return false;
+            tile.x = rect[0];
+            tile.y = rect[1];
+            tile.width = rect[2];
+            tile.height = rect[3];
+        }
+        atlas.pixels.resize(std::size_t(width) * std::size_t(height) * 4);
+        if (!file.read(reinterpret_cast<char *>(atlas.pixels.data()), std::streamsize(atlas.pixels.size())))
+            return false;
+        computeUVs(atlas);
+        return true;
+    }
+
+    void storeCache(const std::string &directory, std::uint64_t key, const TextureAtlas &atlas)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        std::string path = cachePath(directory, key);
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            writeValue(file, CACHE_MAGIC);
+            writeValue(file, CACHE_VERSION);
+            writeValue(file, key);
+            writeValue(file, std::int32_t(atlas.width));
+            writeValue(file, std::int32_t(atlas.height));
+            writeValue(file, std::uint32_t(atlas.tiles.size()));
+            for (const AtlasTile &tile : atlas.tiles)
+            {
+                writeValue(file, std::uint16_t(tile.name.size()));
+                file.write(tile.name.data(), std::streamsize(tile.name.size()));
+                std::int32_t rect[4] = {tile.x, tile.y, tile.width, tile.height};
+                writeValue(file, rect);
+            }
+            file.write(reinterpret_cast<const char *>(atlas.pixels.data()), std::streamsize(atlas.pixels.size()));
+            if (!file)
+                return;
+        }
+        std::filesystem::rename(temporary, path, error);
+    }
+
+    // Shelf packing: tiles sorted by height fill rows left to right. Returns false if they do not fit.
+    bool pack(TextureAtlas &atlas, int size, int padding)
+    {
+        std::vector<std::size_t> order(atlas.tiles.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return atlas.tiles[a].height > atlas.tiles[b].height; });
+
+        int x = 0, y = 0, shelfHeight = 0;
+        for (std::size_t i : order)
+        {
+            AtlasTile &tile = atlas.tiles[i];
+            int w = tile.width + 2 * padding;
+            int h = tile.height + 2 * padding;
+            if (x + w > size)
+            {
+                x = 0;
+                y += shelfHeight;
+                shelfHeight = 0;
+            }
+            if (w > size || y + h > size)
+                return false;
+            tile.x = x + padding;
+            tile.y = y + padding;
+            x += w;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        atlas.width = size;
+        atlas.height = size;
+        return true;
+    }
+
+    // Copies a tile rectangle and extrudes its edge pixels into the padding around it
+    void blit(TextureAtlas &atlas, const AtlasTile &tile, const DecodedImage &image, const TileSource &source, int padding)
+    {
+        for (int dy = -padding; dy < tile.height + padding; ++dy)
+        {
+            int sy = source.y + std::clamp(dy, 0, tile.height - 1);
+            for (int dx = -padding; dx < tile.width + padding; ++dx)
+            {
+                int sx = source.x + std::clamp(dx, 0, tile.width - 1);
+                const std::uint8_t *from = &image.rgba[(std::size_t(sy) * std::size_t(image.width) + std::size_t(sx)) * 4];
+                std::uint8_t *to = &atlas.pixels[(std::size_t(tile.y + dy) * std::size_t(atlas.width) + std::size_t(tile.x + dx)) * 4];
+                std::memcpy(to, from, 4);
+            }
+        }
+    }
+}
+
+int TextureAtlas::tileIndex(const std::string &name) const
+{
+    for (std::size_t i = 0; i < tiles.size(); ++i)
+        if (tiles[i].name == name)
+            return int(i);
+    return -1;
+}
+
+TextureAtlas loadOrBuildAtlas(const std::vector<TileSource> &sources, const AtlasOptions &options, bool *fromCache)
+{
+    if (fromCache)
+        *fromCache = false;
+
+    // Read every source file once; the key covers their bytes, so editing an image rebuilds the atlas
+    std::unordered_map<std::string, std::size_t> fileIndex;
+    std::vector<std::vector<std::uint8_t>> files;
+    std::uint64_t key = 0xCBF29CE484222325ull;
+    key = fnv1a(key, &CACHE_VERSION, sizeof(CACHE_VERSION));
+    key = fnv1a(key, &options.padding, sizeof(options.padding));
+    for (const TileSource &source : sources)
+    {
+        auto [it, inserted] = fileIndex.try_emplace(source.file, files.size());
+        if (inserted)
+        {
+            files.emplace_back();
+            if (!readImageFile(source.file, files.back()))
+                return {};
+        }
+        const std::vector<std::uint8_t> &bytes = files[it->second];
+        int rect[4] = {source.x, source.y, source.width, source.height};
+        key = fnv1a(key, source.name);
+        key = fnv1a(key, bytes.data(), bytes.size());
+        key = fnv1a(key, rect, sizeof(rect));
+    }
+
+    TextureAtlas atlas;
+    if (!options.cacheDirectory.empty() && loadCache(cachePath(options.cacheDirectory, key), key, sources.size(), atlas))
+    {
+        if (fromCache)
+            *fromCache = true;
+        return atlas;
+    }
+    atlas = {};
+
+    // Decode (always to RGBA, top row first), in parallel when a job system was given
+    std::vector<const std::vector<std::uint8_t> *> encoded;
+    for (const std::vector<std::uint8_t> &bytes : files)
+        encoded.push_back(&bytes);
+    std::vector<DecodedImage> images = decodeImages(encoded, options.jobs);
+    for (const DecodedImage &image : images)
+        if (image.empty())
+            return {};
+
+    // Resolve the source rectangles
+    std::vector<TileSource> rects = sources;
+    atlas.tiles.resize(sources.size());
+    long long area = 0;
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        TileSource &source = rects[i];
+        const DecodedImage &image = images[fileIndex[source.file]];
+        if (source.width == 0 || source.height == 0)
+        {
+            source.width = image.width;
+            source.height = image.height;
+        }
+        if (source.x < 0 || source.y < 0 || source.width <= 0 || source.height <= 0 || source.x + source.width > image.width ||
+            source.y + source.height > image.height)
+            return {};
+        atlas.tiles[i].name = source.name;
+        atlas.tiles[i].width = source.width;
+        atlas.tiles[i].height = source.height;
+        area += (long long)(source.width + 2 * options.padding) * (source.height + 2 * options.padding);
+    }
+
+    // Smallest power-of-two square that fits, so every mip level divides evenly
+    int size = 1;
+    while ((long long)size * size < area)
+        size *= 2;
+    while (!pack(atlas, size, options.padding))
+    {
+        size *= 2;
+        if (size > MAX_ATLAS_SIZE)
+            return {};
+    }
+
+    atlas.pixels.assign(std::size_t(atlas.width) * std::size_t(atlas.height) * 4, 0);
+    for (std::size_t i = 0; i < rects.size(); ++i)
+        blit(atlas, atlas.tiles[i], images[fileIndex[rects[i].file]], rects[i], options.padding);
+    computeUVs(atlas);
+
+    if (!options.cacheDirectory.empty())
+        storeCache(options.cacheDirectory, key, atlas);
+    return atlas;
+}
+
+std::vector<TileSource> blockTileSources(const std::string &imageDirectory)
+{
+    std::vector<TileSource> sources;
+    for (int i = 0; i < 16; ++i)
+    {
+        TileSource source;
+        source.name = SHEET_TILES[i];
+        source.file = imageDirectory + "/minecraft_textures.jpg";
+        source.x = (i % 4) * SHEET_CELL + SHEET_BORDER;
+        source.y = (i / 4) * SHEET_CELL + SHEET_BORDER;
+        source.width = SHEET_CELL - 2 * SHEET_BORDER;
+        source.height = SHEET_CELL - 2 * SHEET_BORDER;
+        sources.push_back(source);
+    }
+    return sources;
+}
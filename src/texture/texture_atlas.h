@@ -0,0 +1,60 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <cstdint> // For std::uint8_t, std::uint64_t
+#include <string>  // For tile names and paths
+#include <vector>  // For pixels and tile tables
+
+class JobSystem;
+
+// One input texture: a whole image file, or a rectangle of one (for sprite sheets)
+struct TileSource
+{
+    std::string name;
+    std::string file;
+    int x = 0, y = 0;          // Top-left of the rectangle in the image, rows counted from the top
+    int width = 0, height = 0; // 0 = the whole image
+};
+
+// Where a tile ended up in the atlas. The rectangle excludes the padding. v runs bottom to top, so
+// (u0, v0) is the bottom-left corner of the tile as it appears in the source image.
+struct AtlasTile
+{
+    std::string name;
+    int x = 0, y = 0, width = 0, height = 0; // Pixel rectangle, rows counted from the top
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+// RGBA8 atlas image, row 0 first (the top row of every tile comes first, upload it as is) plus the tile table.
+// Tile index i is the i-th source given to the builder, which is what BlockInfo::tiles refers to.
+struct TextureAtlas
+{
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+    std::vector<AtlasTile> tiles;
+
+    bool empty() const { return pixels.empty(); }
+    int tileIndex(const std::string &name) const; // -1 if unknown
+};
+
+struct AtlasOptions
+{
+    // Pixels around every tile filled by repeating its edge, so linear filtering and the first
+    // log2(padding) mip levels never pick up a neighbouring tile
+    int padding = 16;
+    // Where packed atlases are cached, keyed by a hash of the source files and these options; empty disables it
+    std::string cacheDirectory;
+    // Decodes the source images on this job system when set, otherwise on the calling thread
+    JobSystem *jobs = nullptr;
+};
+
+// Packs the tiles (shelf packing into the smallest power-of-two square that fits) or, when the cache holds
+// an atlas built from identical inputs, loads that instead. Returns an empty atlas if a source is missing.
+// fromCache is optional and tells which of the two happened.
+TextureAtlas loadOrBuildAtlas(const std::vector<TileSource> &sources, const AtlasOptions &options, bool *fromCache = nullptr);
+
+// The block face textures in tile index order, cut out of the 4x4 sheet in imageDirectory
+std::vector<TileSource> blockTileSources(const std::string &imageDirectory);
+
+#endif
@@ -0,0 +1,21 @@
+#include "texture/texture_loader.h"
+
+#include <chrono>  // For timing the build
+#include <utility> // For std::move
+
+TextureLoader::TextureLoader(JobSystem &jobs, std::vector<TileSource> sources, AtlasOptions options, int layerSize) : m_jobs(jobs)
+{
+    options.jobs = &jobs;
+    m_job = jobs.schedule([this, sources = std::move(sources), options, layerSize]
+    {
+        auto start = std::chrono::steady_clock::now();
+        // The atlas is only needed to cut the layers from, so it is dropped right after
+        m_layers = layersFromAtlas(loadOrBuildAtlas(sources, options, &m_fromCache), layerSize, options.jobs);
+        m_buildMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    });
+}
+
+TextureLoader::~TextureLoader()
+{
+    m_jobs.wait(m_job);
+}
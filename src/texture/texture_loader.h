@@ -0,0 +1,39 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <utility> // For std::move
+#include <vector>  // For the tile sources
+
+#include "core/job_system.h"
+#include "texture/texture_array.h"
+#include "texture/texture_atlas.h"
+
+// Builds the texture array layers in the background: one job packs (or loads from the cache) the atlas and
+// cuts it into layers, decoding the source images and resampling the layers in parallel on the same job
+// system. The render thread polls ready() every frame and keeps drawing with a placeholder until then.
+class TextureLoader
+{
+public:
+    // Starts right away; options.jobs is set to jobs
+    TextureLoader(JobSystem &jobs, std::vector<TileSource> sources, AtlasOptions options, int layerSize);
+    ~TextureLoader(); // Waits for the job, it references this object
+
+    TextureLoader(const TextureLoader &) = delete;
+    TextureLoader &operator=(const TextureLoader &) = delete;
+
+    bool ready() const { return m_job->finished.load(std::memory_order_acquire); }
+
+    // Only valid once ready(). takeLayers() moves the layers out (empty if a source failed to load).
+    TextureLayers takeLayers() { return std::move(m_layers); }
+    bool fromCache() const { return m_fromCache; }
+    double buildMillis() const { return m_buildMillis; } // Time the job took from start to finish
+
+private:
+    JobSystem &m_jobs;
+    JobHandle m_job;
+    TextureLayers m_layers;
+    bool m_fromCache = false;
+    double m_buildMillis = 0.0;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#include "world/block.h"
+
+// Tile indices are positions in blockTileSources() (texture/texture_atlas.cpp), which cuts them row by row
+// from the top-left of images/minecraft_textures.jpg (4x4 grid):
+//  0 gold ore     1 ice          2 sandstone    3 dirt
+//  4 cobblestone  5 brick        6 red sand     7 sand
+//  8 stone        9 quartz      10 blue brick  11 planks
+// 12 stone brick 13 mossy stone 14 dark dirt   15 gravel
+// Face order: -X, +X, -Y, +Y, -Z, +Z
+const BlockInfo BLOCK_TABLE[Blocks::COUNT] = {
+    {"air", false, {0, 0, 0, 0, 0, 0}},
+    {"stone", true, {8, 8, 8, 8, 8, 8}},
+    {"cobblestone", true, {4, 4, 4, 4, 4, 4}},
+    {"dirt", true, {3, 3, 3, 3, 3, 3}},
+    {"grass", true, {3, 3, 3, 13, 3, 3}},
+    {"sand", true, {7, 7, 7, 7, 7, 7}},
+    {"gravel", true, {15, 15, 15, 15, 15, 15}},
+    {"sandstone", true, {2, 2, 2, 2, 2, 2}},
+    {"planks", true, {11, 11, 11, 11, 11, 11}},
+    {"brick", true, {5, 5, 5, 5, 5, 5}},
+    {"stone_brick", true, {12, 12, 12, 12, 12, 12}},
+    {"mossy_stone", true, {13, 13, 13, 13, 13, 13}},
+    {"gold_ore", true, {0, 0, 0, 0, 0, 0}},
+    {"ice", true, {1, 1, 1, 1, 1, 1}},
+    {"lamp", true, {9, 9, 9, 9, 9, 9}, 15},
+};
@@ -0,0 +1,67 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <cstdint> // For std::uint16_t
+
+// Every voxel in the world is just a block ID; the properties of each ID live in a static table
+using BlockID = std::uint16_t;
+
+namespace Blocks
+{
+    // IDs are stable because they end up in save files, so only ever append to this list
+    enum : BlockID
+    {
+        AIR = 0,
+        STONE,
+        COBBLESTONE,
+        DIRT,
+        GRASS,
+        SAND,
+        GRAVEL,
+        SANDSTONE,
+        PLANKS,
+        BRICK,
+        STONE_BRICK,
+        MOSSY_STONE,
+        GOLD_ORE,
+        ICE,
+        LAMP,
+        COUNT
+    };
+}
+
+// Cube faces, in the order used by the mesher and the face-normal index in the vertex data
+enum class Face : std::uint8_t
+{
+    NEG_X = 0,
+    POS_X,
+    NEG_Y,
+    POS_Y,
+    NEG_Z,
+    POS_Z,
+    COUNT
+};
+
+struct BlockInfo
+{
+    const char *name;
+    bool opaque;             // Hides the faces of neighbouring blocks
+    std::uint8_t tiles[6];   // Texture tile per face (indexed by Face) in images/minecraft_textures.jpg
+    std::uint8_t light = 0;  // Block light emitted, 0..15
+};
+
+// Static properties of every block ID, defined in block.cpp
+extern const BlockInfo BLOCK_TABLE[Blocks::COUNT];
+
+// Returns the static properties of a block ID (unknown IDs are treated as air).
+// Inline because the mesher calls it for every visible face candidate.
+inline const BlockInfo &blockInfo(BlockID id)
+{
+    return id < Blocks::COUNT ? BLOCK_TABLE[id] : BLOCK_TABLE[Blocks::AIR];
+}
+
+inline bool isOpaque(BlockID id) { return blockInfo(id).opaque; }
+inline int lightEmission(BlockID id) { return blockInfo(id).light; }
+inline bool isSolid(BlockID id) { return id != Blocks::AIR; } // Physics bodies collide with it
+
+#endif
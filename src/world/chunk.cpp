@@ -0,0 +1,379 @@
+#include "world/chunk.h"
+
+#include <algorithm> // For std::fill_n
+#include <cstring>   // For std::memcpy
+#include <utility>   // For std::move
+
+namespace
+{
+    // Smallest supported palette index width (1, 2, 4 or 8 bits) that can address paletteSize entries,
+    // or 16 when the palette no longer fits in 8 bits
+    int bitsForPalette(std::size_t paletteSize)
+    {
+        int bits = 1;
+        while ((std::size_t(1) << bits) < paletteSize)
+            bits *= 2;
+        return bits;
+    }
+
+    // Serialized chunks are raw little-endian; every supported target is little-endian
+    constexpr std::uint8_t CHUNK_FORMAT_VERSION = 1;
+
+    template <typename T>
+    void append(std::vector<std::uint8_t> &out, const T *values, std::size_t count)
+    {
+        std::size_t offset = out.size();
+        out.resize(offset + count * sizeof(T));
+        std::memcpy(out.data() + offset, values, count * sizeof(T));
+    }
+
+    template <typename T>
+    bool consume(const std::uint8_t *&data, const std::uint8_t *end, T *values, std::size_t count)
+    {
+        if (std::size_t(end - data) < count * sizeof(T))
+            return false;
+        std::memcpy(values, data, count * sizeof(T));
+        data += count * sizeof(T);
+        return true;
+    }
+}
+
+void ChunkSection::fill(BlockID id)
+{
+    m_directNonAir = 0;
+    m_palette.assign(1, id);
+    m_counts.assign(1, std::uint16_t(SECTION_VOLUME));
+    m_data.clear();
+    m_data.shrink_to_fit(); // Uniform sections keep no index storage at all
+    m_bits = 0;
+}
+
+void ChunkSection::setBlock(int x, int y, int z, BlockID id)
+{
+    int i = index(x, y, z);
+    if (m_bits == DIRECT_BITS)
+    {
+        BlockID old = BlockID(readIndex(i));
+        if (old == id)
+            return;
+        m_directNonAir = std::uint16_t(m_directNonAir + (old == Blocks::AIR) - (id == Blocks::AIR));
+        writeIndex(i, id);
+        return;
+    }
+
+    unsigned oldEntry = m_bits ? readIndex(i) : 0;
+    if (m_palette[oldEntry] == id)
+        return;
+
+    // May grow the index width; existing palette indices stay valid across a repack
+    int newEntry = findOrAddPaletteEntry(id);
+    if (m_bits == DIRECT_BITS)
+    {
+        // The palette just overflowed 8 bits and was converted, store the raw ID instead
+        setBlock(x, y, z, id);
+        return;
+    }
+    --m_counts[oldEntry];
+    ++m_counts[newEntry];
+    writeIndex(i, unsigned(newEntry));
+
+    // Collapse back to the zero-storage fast path once a single block type fills the section
+    if (m_counts[newEntry] == SECTION_VOLUME)
+        fill(id);
+}
+
+int ChunkSection::nonAirCount() const
+{
+    if (m_bits == DIRECT_BITS)
+        return m_directNonAir;
+
+    int count = 0;
+    for (std::size_t i = 0; i < m_palette.size(); ++i)
+        if (m_palette[i] != Blocks::AIR)
+            count += m_counts[i];
+    return count;
+}
+
+std::size_t ChunkSection::memoryUsage() const
+{
+    return sizeof(*this) + m_palette.capacity() * sizeof(BlockID) + m_counts.capacity() * sizeof(std::uint16_t) +
+           m_data.capacity() * sizeof(std::uint64_t);
+}
+
+void ChunkSection::serialize(std::vector<std::uint8_t> &out) const
+{
+    // Layout: u8 bits, u16 palette size, palette, packed words (none for uniform sections)
+    std::uint16_t paletteSize = std::uint16_t(m_palette.size());
+    append(out, &m_bits, 1);
+    append(out, &paletteSize, 1);
+    append(out, m_palette.data(), m_palette.size());
+    append(out, m_data.data(), m_data.size());
+}
+
+bool ChunkSection::deserialize(const std::uint8_t *&data, const std::uint8_t *end)
+{
+    std::uint8_t bits = 0;
+    std::uint16_t paletteSize = 0;
+    if (!consume(data, end, &bits, 1) || !consume(data, end, &paletteSize, 1))
+        return false;
+
+    bool validBits = bits == 0 || bits == 1 || bits == 2 || bits == 4 || bits == 8 || bits == DIRECT_BITS;
+    bool validPalette = bits == DIRECT_BITS ? paletteSize == 0 : (paletteSize >= 1 && paletteSize <= (1u << bits));
+    if (!validBits || !validPalette)
+        return false;
+
+    m_bits = bits;
+    m_palette.resize(paletteSize);
+    m_data.resize(std::size_t(SECTION_VOLUME) * bits / 64);
+    if (!consume(data, end, m_palette.data(), m_palette.size()) || !consume(data, end, m_data.data(), m_data.size()))
+        return false;
+
+    // Reference counts (or the direct-mode non-air count) are not stored, rebuild them from the indices
+    m_directNonAir = 0;
+    m_counts.assign(m_palette.size(), 0);
+    if (bits == 0)
+    {
+        m_counts[0] = std::uint16_t(SECTION_VOLUME);
+        return true;
+    }
+    for (int i = 0; i < SECTION_VOLUME; ++i)
+    {
+        unsigned value = readIndex(i);
+        if (bits == DIRECT_BITS)
+            m_directNonAir = std::uint16_t(m_directNonAir + (value != Blocks::AIR));
+        else if (value >= paletteSize)
+            return false;
+        else
+            ++m_counts[value];
+    }
+    return true;
+}
+
+void ChunkSection::writeIndex(int i, unsigned value)
+{
+    unsigned bit = unsigned(i) * m_bits;
+    std::uint64_t mask = ((std::uint64_t(1) << m_bits) - 1) << (bit & 63);
+    std::uint64_t &word = m_data[bit >> 6];
+    word = (word & ~mask) | ((std::uint64_t(value) << (bit & 63)) & mask);
+}
+
+int ChunkSection::findOrAddPaletteEntry(BlockID id)
+{
+    int freeEntry = -1;
+    for (std::size_t i = 0; i < m_palette.size(); ++i)
+    {
+        if (m_palette[i] == id)
+            return int(i);
+        if (m_counts[i] == 0 && freeEntry < 0)
+            freeEntry = int(i);
+    }
+
+    // Reuse an entry no block points at any more before growing the palette
+    if (freeEntry >= 0)
+    {
+        m_palette[freeEntry] = id;
+        return freeEntry;
+    }
+
+    if (m_palette.size() + 1 > (std::size_t(1) << m_bits))
+    {
+        int bits = bitsForPalette(m_palette.size() + 1);
+        if (bits == DIRECT_BITS)
+        {
+            convertToDirect();
+            return -1;
+        }
+        repack(bits);
+    }
+
+    m_palette.push_back(id);
+    m_counts.push_back(0);
+    return int(m_palette.size() - 1);
+}
+
+void ChunkSection::repack(int newBits)
+{
+    std::vector<std::uint64_t> packed(std::size_t(SECTION_VOLUME) * newBits / 64, 0);
+    for (int i = 0; i < SECTION_VOLUME; ++i)
+    {
+        std::uint64_t value = m_bits ? readIndex(i) : 0;
+        unsigned bit = unsigned(i) * unsigned(newBits);
+        packed[bit >> 6] |= value << (bit & 63);
+    }
+    m_data = std::move(packed);
+    m_bits = std::uint8_t(newBits);
+}
+
+void ChunkSection::convertToDirect()
+{
+    std::vector<std::uint64_t> packed(std::size_t(SECTION_VOLUME) * DIRECT_BITS / 64, 0);
+    for (int i = 0; i < SECTION_VOLUME; ++i)
+    {
+        std::uint64_t id = m_palette[readIndex(i)];
+        unsigned bit = unsigned(i) * DIRECT_BITS;
+        packed[bit >> 6] |= id << (bit & 63);
+    }
+    m_directNonAir = std::uint16_t(nonAirCount());
+    m_data = std::move(packed);
+    m_bits = DIRECT_BITS;
+
+    // Direct mode needs neither the palette nor its reference counts
+    m_palette.clear();
+    m_palette.shrink_to_fit();
+    m_counts.clear();
+    m_counts.shrink_to_fit();
+}
+
+void NibbleArray::set(int i, int level)
+{
+    if (!m_data)
+    {
+        if (level == m_fill)
+            return;
+        m_data = std::make_unique<std::uint8_t[]>(SECTION_VOLUME / 2);
+        std::fill_n(m_data.get(), SECTION_VOLUME / 2, std::uint8_t(m_fill | (m_fill << 4)));
+    }
+    int shift = (i & 1) * 4;
+    m_data[i >> 1] = std::uint8_t((m_data[i >> 1] & ~(15 << shift)) | (level << shift));
+}
+
+void NibbleArray::fill(int level)
+{
+    m_data.reset();
+    m_fill = std::uint8_t(level);
+}
+
+std::array<NibbleArray, SECTIONS_PER_CHUNK> Chunk::makeLight(int level)
+{
+    std::array<NibbleArray, SECTIONS_PER_CHUNK> light;
+    for (NibbleArray &section : light)
+        section.fill(level);
+    return light;
+}
+
+int Chunk::skyLight(int x, int y, int z) const
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return y < 0 ? 0 : 15;
+    return m_skyLight[y / SECTION_SIZE].get(ChunkSection::index(x, y % SECTION_SIZE, z));
+}
+
+int Chunk::blockLight(int x, int y, int z) const
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return 0;
+    return m_blockLight[y / SECTION_SIZE].get(ChunkSection::index(x, y % SECTION_SIZE, z));
+}
+
+void Chunk::setSkyLight(int x, int y, int z, int level)
+{
+    if (y >= 0 && y < CHUNK_HEIGHT)
+        m_skyLight[y / SECTION_SIZE].set(ChunkSection::index(x, y % SECTION_SIZE, z), level);
+}
+
+void Chunk::setBlockLight(int x, int y, int z, int level)
+{
+    if (y >= 0 && y < CHUNK_HEIGHT)
+        m_blockLight[y / SECTION_SIZE].set(ChunkSection::index(x, y % SECTION_SIZE, z), level);
+}
+
+BlockID Chunk::getBlock(int x, int y, int z) const
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return Blocks::AIR;
+
+    const ChunkSection *s = m_sections[y / SECTION_SIZE].get();
+    return s ? s->getBlock(x, y % SECTION_SIZE, z) : BlockID(Blocks::AIR);
+}
+
+void Chunk::setBlock(int x, int y, int z, BlockID id)
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return;
+
+    int sectionY = y / SECTION_SIZE;
+    int localY = y % SECTION_SIZE;
+    std::unique_ptr<ChunkSection> &s = m_sections[sectionY];
+    if (!s)
+    {
+        if (id == Blocks::AIR)
+            return; // Writing air into an unallocated section changes nothing
+        s = std::make_unique<ChunkSection>();
+    }
+
+    if (s->getBlock(x, localY, z) == id)
+        return;
+
+    s->setBlock(x, localY, z, id);
+    if (s->isEmpty())
+        s.reset();
+    m_unsaved = true;
+
+    // Faces on a section border are also owned by the neighbouring section
+    markSectionDirty(sectionY);
+    if (localY == 0 && sectionY > 0)
+        markSectionDirty(sectionY - 1);
+    if (localY == SECTION_SIZE - 1 && sectionY < SECTIONS_PER_CHUNK - 1)
+        markSectionDirty(sectionY + 1);
+}
+
+int Chunk::allocatedSections() const
+{
+    int count = 0;
+    for (const auto &s : m_sections)
+        if (s)
+            ++count;
+    return count;
+}
+
+std::size_t Chunk::memoryUsage() const
+{
+    std::size_t bytes = sizeof(*this);
+    for (const auto &s : m_sections)
+        if (s)
+            bytes += s->memoryUsage();
+    for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+        bytes += m_skyLight[sectionY].memoryUsage() + m_blockLight[sectionY].memoryUsage();
+    return bytes;
+}
+
+void Chunk::serialize(std::vector<std::uint8_t> &out) const
+{
+    // Layout: u8 version, u16 mask of allocated sections, then each allocated section bottom to top
+    std::uint16_t mask = 0;
+    for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+        if (m_sections[sectionY])
+            mask |= std::uint16_t(1u << sectionY);
+
+    append(out, &CHUNK_FORMAT_VERSION, 1);
+    append(out, &mask, 1);
+    for (const auto &s : m_sections)
+        if (s)
+            s->serialize(out);
+}
+
+std::unique_ptr<Chunk> Chunk::deserialize(ChunkPos pos, const std::uint8_t *data, std::size_t size)
+{
+    const std::uint8_t *end = data + size;
+    std::uint8_t version = 0;
+    std::uint16_t mask = 0;
+    if (!consume(data, end, &version, 1) || version != CHUNK_FORMAT_VERSION || !consume(data, end, &mask, 1))
+        return nullptr;
+
+    auto chunk = std::make_unique<Chunk>(pos);
+    for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+    {
+        if (!(mask & (1u << sectionY)))
+            continue;
+        auto section = std::make_unique<ChunkSection>();
+        if (!section->deserialize(data, end))
+            return nullptr;
+        if (!section->isEmpty())
+            chunk->m_sections[sectionY] = std::move(section);
+    }
+    if (data != end)
+        return nullptr;
+
+    chunk->markAllDirty();
+    return chunk;
+}
@@ -0,0 +1,186 @@
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include <array>      // For std::array, the fixed-size section table of a chunk
+#include <cstddef>    // For std::size_t
+#include <cstdint>    // For fixed-width integer types
+#include <functional> // For std::hash
+#include <memory>     // For std::unique_ptr, sections are allocated lazily
+#include <vector>     // For the section palette and packed indices
+
+#include "world/block.h"
+
+// A chunk is a 16x256x16 column of blocks, split vertically into 16 sections of 16x16x16.
+// Sections that contain only air are never allocated, so the sky above the terrain costs nothing.
+constexpr int CHUNK_SIZE = 16;                              // Width and depth of a chunk (x and z)
+constexpr int CHUNK_HEIGHT = 256;                           // Height of a chunk (y)
+constexpr int SECTION_SIZE = 16;                            // Edge length of a cubic section
+constexpr int SECTIONS_PER_CHUNK = CHUNK_HEIGHT / SECTION_SIZE;
+constexpr int SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+
+// Chunk coordinates, i.e. world block coordinates divided by CHUNK_SIZE
+struct ChunkPos
+{
+    int x = 0;
+    int z = 0;
+
+    bool operator==(const ChunkPos &o) const { return x == o.x && z == o.z; }
+    bool operator!=(const ChunkPos &o) const { return !(*this == o); }
+};
+
+struct ChunkPosHash
+{
+    std::size_t operator()(const ChunkPos &p) const
+    {
+        // Pack both coordinates into one 64-bit key and let std::hash mix it
+        std::uint64_t key = (std::uint64_t(std::uint32_t(p.x)) << 32) | std::uint32_t(p.z);
+        return std::hash<std::uint64_t>{}(key);
+    }
+};
+
+// 16x16x16 cube of blocks stored as a palette plus bit-packed palette indices.
+// A section holding a single block type (all stone, all water, ...) stores no indices at all;
+// otherwise each block takes 1, 2, 4 or 8 bits depending on how many distinct IDs it has.
+// Past 256 distinct IDs the palette is dropped and the raw 16-bit IDs are stored directly.
+// Storage order is x fastest, then z, then y.
+class ChunkSection
+{
+public:
+    explicit ChunkSection(BlockID fill = Blocks::AIR) { this->fill(fill); }
+
+    static int index(int x, int y, int z) { return (y * SECTION_SIZE + z) * SECTION_SIZE + x; }
+
+    BlockID getBlock(int x, int y, int z) const
+    {
+        if (m_bits == 0)
+            return m_palette[0];
+        unsigned value = readIndex(index(x, y, z));
+        return m_bits == DIRECT_BITS ? BlockID(value) : m_palette[value];
+    }
+    void setBlock(int x, int y, int z, BlockID id);
+
+    // Replaces every block with id and drops the index storage
+    void fill(BlockID id);
+
+    // Number of non-air blocks, used to free sections that become empty
+    int nonAirCount() const;
+    bool isEmpty() const
+    {
+        // A palette section that became all air has already collapsed to the uniform form
+        return m_bits == DIRECT_BITS ? m_directNonAir == 0 : (m_bits == 0 && m_palette[0] == Blocks::AIR);
+    }
+
+    bool isUniform() const { return m_bits == 0; }
+    int bitsPerBlock() const { return m_bits; }
+    int paletteSize() const { return int(m_palette.size()); }
+
+    std::size_t memoryUsage() const;
+
+    // Appends the section in its in-memory form (index width, palette, packed words) so loading it back
+    // is a copy instead of 4096 setBlock calls. deserialize returns false on malformed input and advances data.
+    void serialize(std::vector<std::uint8_t> &out) const;
+    bool deserialize(const std::uint8_t *&data, const std::uint8_t *end);
+
+    // Largest serialize() output: the header and one block ID per block in direct mode (any palette is smaller)
+    static constexpr std::size_t MAX_SERIALIZED_SIZE = 3 + std::size_t(SECTION_VOLUME) * sizeof(BlockID);
+
+private:
+    static constexpr int DIRECT_BITS = 16; // Index width at which the packed values are block IDs, not palette indices
+
+    unsigned readIndex(int i) const
+    {
+        unsigned bit = unsigned(i) * m_bits; // Bit widths are powers of two, so an index never straddles two words
+        return unsigned(m_data[bit >> 6] >> (bit & 63)) & ((1u << m_bits) - 1);
+    }
+    void writeIndex(int i, unsigned value);
+
+    int findOrAddPaletteEntry(BlockID id); // Returns -1 if the section had to switch to direct mode
+    void repack(int newBits);
+    void convertToDirect();
+
+    std::vector<BlockID> m_palette;            // Distinct block IDs; entries with a zero count are free for reuse
+    std::vector<std::uint16_t> m_counts;       // How many blocks use each palette entry
+    std::vector<std::uint64_t> m_data;         // Bit-packed palette indices, empty for uniform sections
+    std::uint16_t m_directNonAir = 0;          // Non-air blocks, only tracked in direct mode (no palette counts)
+    std::uint8_t m_bits = 0;                   // Bits per index: 0 (uniform), 1, 2, 4, 8 or DIRECT_BITS
+};
+
+// 4-bit light levels of one section, two per byte, in ChunkSection::index order. Like a uniform section,
+// a section at a single light level (open sky, solid rock) stores just that level and no array.
+class NibbleArray
+{
+public:
+    explicit NibbleArray(int fill = 0) : m_fill(std::uint8_t(fill)) {}
+
+    int get(int i) const { return m_data ? (m_data[i >> 1] >> ((i & 1) * 4)) & 15 : m_fill; }
+    void set(int i, int level);
+
+    // Sets every entry to level and drops the array
+    void fill(int level);
+
+    bool isUniform() const { return !m_data; }
+    std::size_t memoryUsage() const { return m_data ? SECTION_VOLUME / 2 : 0; }
+
+private:
+    std::unique_ptr<std::uint8_t[]> m_data;
+    std::uint8_t m_fill;
+};
+
+class Chunk
+{
+public:
+    explicit Chunk(ChunkPos pos) : m_pos(pos) {}
+
+    ChunkPos position() const { return m_pos; }
+
+    // Local coordinates: x and z in [0, CHUNK_SIZE), y in [0, CHUNK_HEIGHT)
+    BlockID getBlock(int x, int y, int z) const;
+    void setBlock(int x, int y, int z, BlockID id);
+
+    // Returns nullptr for sections that hold only air
+    const ChunkSection *section(int sectionY) const { return m_sections[sectionY].get(); }
+
+    // Bitmask of sections whose mesh needs rebuilding (bit n = section n)
+    std::uint16_t dirtySections() const { return m_dirtySections; }
+    void markSectionDirty(int sectionY) { m_dirtySections |= std::uint16_t(1u << sectionY); }
+    void markAllDirty() { m_dirtySections = 0xFFFF; }
+    void clearDirty(int sectionY) { m_dirtySections &= std::uint16_t(~(1u << sectionY)); }
+
+    // Light levels 0..15 kept up to date by LightEngine; y outside the chunk reads as open sky above and darkness
+    // below. A chunk that was never lit reads full sky light and no block light everywhere.
+    // Light is derived from the blocks, so it is not saved.
+    int skyLight(int x, int y, int z) const;
+    int blockLight(int x, int y, int z) const;
+    void setSkyLight(int x, int y, int z, int level);
+    void setBlockLight(int x, int y, int z, int level);
+    NibbleArray &skyLightSection(int sectionY) { return m_skyLight[sectionY]; }
+    NibbleArray &blockLightSection(int sectionY) { return m_blockLight[sectionY]; }
+    bool isLit() const { return m_lit; }
+    void markLit() { m_lit = true; }
+
+    // Set by every block change, cleared once the chunk has been handed to storage
+    bool hasUnsavedChanges() const { return m_unsaved; }
+    void markSaved() { m_unsaved = false; }
+
+    int allocatedSections() const;
+    std::size_t memoryUsage() const;
+
+    // Uncompressed binary form stored in region files. deserialize returns nullptr on malformed data.
+    void serialize(std::vector<std::uint8_t> &out) const;
+    // Upper bound of serialize() output: version, section mask and every section at its largest
+    static constexpr std::size_t MAX_SERIALIZED_SIZE = 3 + SECTIONS_PER_CHUNK * ChunkSection::MAX_SERIALIZED_SIZE;
+    static std::unique_ptr<Chunk> deserialize(ChunkPos pos, const std::uint8_t *data, std::size_t size);
+
+private:
+    static std::array<NibbleArray, SECTIONS_PER_CHUNK> makeLight(int level);
+
+    ChunkPos m_pos;
+    std::array<std::unique_ptr<ChunkSection>, SECTIONS_PER_CHUNK> m_sections;
+    std::array<NibbleArray, SECTIONS_PER_CHUNK> m_skyLight = makeLight(15);
+    std::array<NibbleArray, SECTIONS_PER_CHUNK> m_blockLight = makeLight(0);
+    std::uint16_t m_dirtySections = 0;
+    bool m_unsaved = false;
+    bool m_lit = false;
+};
+
+#endif
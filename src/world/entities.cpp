@@ -0,0 +1,140 @@
+#include "world/entities.h"
+
+#include <cmath> // For std::sin, std::cos
+
+#include "world/voxel_raycast.h"
+
+namespace
+{
+    constexpr float MOB_WALK_SPEED = 2.5f;      // Blocks per second
+    constexpr float ITEM_POP_SPEED = 4.0f;      // Upwards, when the item is dropped
+    constexpr float ITEM_FRICTION = 0.6f;       // Horizontal speed kept per tick on the ground
+    constexpr float ITEM_SPIN_SPEED = 1.5f;     // Radians per second
+    constexpr float ITEM_LIFETIME = 300.0f;     // Seconds
+    constexpr float PROJECTILE_GRAVITY = 20.0f; // Blocks per second squared
+    constexpr float PROJECTILE_LIFETIME = 60.0f;
+    constexpr std::size_t GRAIN_SIZE = 1024;    // Entities per job
+
+    const PhysicsSettings ITEM_PHYSICS{28.0f, 40.0f, 0.0f}; // Items never step up
+
+    std::uint32_t nextRandom(std::uint32_t &state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    void settle(const World &world, DroppedItem &item, PhysicsBody &body, float seconds)
+    {
+        if (body.onGround)
+        {
+            body.velocity.x *= ITEM_FRICTION;
+            body.velocity.z *= ITEM_FRICTION;
+        }
+        stepBody(world, body, seconds, ITEM_PHYSICS);
+        item.spin += ITEM_SPIN_SPEED * seconds;
+    }
+
+    void fly(const World &world, Projectile &projectile, float seconds)
+    {
+        if (projectile.stuck)
+            return;
+        projectile.velocity.y -= PROJECTILE_GRAVITY * seconds;
+        Vec3 step = projectile.velocity * seconds;
+        RayHit hit = raycast(world, projectile.position, step, length(step));
+        if (hit.hit)
+        {
+            projectile.position += normalize(step) * hit.distance;
+            projectile.velocity = Vec3{};
+            projectile.stuck = true;
+        }
+        else
+            projectile.position += step;
+    }
+}
+
+// Turns now and then, and right away when a wall stopped the last step on either axis (the sweep zeroes each
+// blocked axis on its own, so sliding along a wall counts too). Ledges are walked up by the physics.
+void wander(Mob &mob, PhysicsBody &body, float walkSpeed)
+{
+    float walkX = std::sin(mob.heading) * walkSpeed;
+    float walkZ = -std::cos(mob.heading) * walkSpeed;
+    bool blocked = (walkX != 0.0f && body.velocity.x == 0.0f) || (walkZ != 0.0f && body.velocity.z == 0.0f);
+    if (blocked || --mob.ticksUntilTurn <= 0)
+    {
+        mob.heading = float(nextRandom(mob.random) % 6283) / 1000.0f;
+        mob.ticksUntilTurn = 10 + int(nextRandom(mob.random) % 80);
+        walkX = std::sin(mob.heading) * walkSpeed;
+        walkZ = -std::cos(mob.heading) * walkSpeed;
+    }
+    body.velocity.x = walkX;
+    body.velocity.z = walkZ;
+}
+
+Entity spawnMob(EntityRegistry &registry, Vec3 position, std::uint32_t seed)
+{
+    PhysicsBody body;
+    body.position = position;
+    Mob mob;
+    mob.random = seed ? seed : 1; // xorshift never leaves 0
+    return registry.create(body, mob);
+}
+
+Entity dropItem(EntityRegistry &registry, Vec3 position, BlockID block)
+{
+    PhysicsBody body;
+    body.position = position;
+    body.velocity = Vec3{0.0f, ITEM_POP_SPEED, 0.0f};
+    body.halfWidth = 0.125f;
+    body.height = 0.25f;
+    DroppedItem item;
+    item.block = block;
+    return registry.create(body, item, Lifetime{ITEM_LIFETIME});
+}
+
+Entity shootProjectile(EntityRegistry &registry, Vec3 position, Vec3 velocity)
+{
+    Projectile projectile;
+    projectile.position = position;
+    projectile.velocity = velocity;
+    return registry.create(projectile, Lifetime{PROJECTILE_LIFETIME});
+}
+
+void EntitySystems::update(EntityRegistry &registry, const World &world, float seconds, JobSystem *jobs)
+{
+    auto mobs = [&](Entity, Mob &mob, PhysicsBody &body)
+    {
+        wander(mob, body, MOB_WALK_SPEED);
+        stepBody(world, body, seconds);
+    };
+    auto items = [&](Entity, DroppedItem &item, PhysicsBody &body) { settle(world, item, body, seconds); };
+    auto projectiles = [&](Entity, Projectile &projectile) { fly(world, projectile, seconds); };
+    auto age = [&](Entity, Lifetime &lifetime) { lifetime.seconds -= seconds; };
+
+    if (jobs)
+    {
+        JobHandle flying = jobs->schedule([&] { registry.each<Projectile>(projectiles); });
+        registry.each<Mob, PhysicsBody>(*jobs, GRAIN_SIZE, mobs);
+        registry.each<DroppedItem, PhysicsBody>(*jobs, GRAIN_SIZE, items);
+        registry.each<Lifetime>(*jobs, GRAIN_SIZE, age);
+        jobs->wait(flying);
+    }
+    else
+    {
+        registry.each<Mob, PhysicsBody>(mobs);
+        registry.each<DroppedItem, PhysicsBody>(items);
+        registry.each<Projectile>(projectiles);
+        registry.each<Lifetime>(age);
+    }
+
+    // Destroying moves rows around, so it waits until nothing iterates any more
+    m_expired.clear();
+    registry.each<Lifetime>([&](Entity entity, Lifetime &lifetime)
+    {
+        if (lifetime.seconds <= 0.0f)
+            m_expired.push_back(entity);
+    });
+    for (Entity entity : m_expired)
+        registry.destroy(entity);
+}
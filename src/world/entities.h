@@ -0,0 +1,61 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <cstdint> // For the mob random state
+#include <vector>  // For the expired entity list
+
+#include "core/entity_registry.h"
+#include "world/voxel_physics.h"
+
+// The components of mobs, dropped items and projectiles, and the systems that move them every simulation tick.
+// Mobs and items are PhysicsBody boxes colliding with the terrain; projectiles fly along rays instead.
+
+// Walks around on its own, turning now and then and whenever a wall is in the way
+struct Mob
+{
+    float heading = 0.0f;     // Radians; 0 walks towards -Z, like the camera's yaw
+    int ticksUntilTurn = 0;
+    std::uint32_t random = 1; // Own xorshift state, so mobs can think on any worker
+};
+
+// A block that was broken, lying around until it despawns
+struct DroppedItem
+{
+    BlockID block = Blocks::AIR;
+    float spin = 0.0f; // Radians, items turn slowly where they lie
+};
+
+// Flies ballistically and sticks in the first block it hits
+struct Projectile
+{
+    Vec3 position;
+    Vec3 velocity;
+    bool stuck = false;
+};
+
+// The entity is destroyed once this runs out
+struct Lifetime
+{
+    float seconds = 0.0f;
+};
+
+// Sets the mob's walking velocity for the next physics step, picking a new heading when it is time to turn
+void wander(Mob &mob, PhysicsBody &body, float walkSpeed);
+
+Entity spawnMob(EntityRegistry &registry, Vec3 position, std::uint32_t seed);
+Entity dropItem(EntityRegistry &registry, Vec3 position, BlockID block);
+Entity shootProjectile(EntityRegistry &registry, Vec3 position, Vec3 velocity);
+
+class EntitySystems
+{
+public:
+    // One simulation tick. Mobs, then items, run in parallel over the job system's workers when one is given,
+    // while the projectiles (which share no components with them) fly on another worker at the same time.
+    // Entities whose lifetime ran out are destroyed at the end. Only reads the world.
+    void update(EntityRegistry &registry, const World &world, float seconds, JobSystem *jobs = nullptr);
+
+private:
+    std::vector<Entity> m_expired; // Reused every tick
+};
+
+#endif
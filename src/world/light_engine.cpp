@@ -0,0 +1,317 @@
+#include "world/light_engine.h"
+
+#include <algorithm> // For std::max, std::min
+
+namespace
+{
+    constexpr int MAX_LIGHT = 15;
+
+    // The six neighbours, in Face order; index 2 is straight down
+    constexpr int DIRECTIONS[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    constexpr int DOWN = 2;
+
+    // One above the highest allocated section of a chunk, in blocks; nothing above it blocks the sky
+    int sectionTop(const Chunk &chunk)
+    {
+        for (int sectionY = SECTIONS_PER_CHUNK - 1; sectionY >= 0; --sectionY)
+            if (chunk.section(sectionY))
+                return (sectionY + 1) * SECTION_SIZE;
+        return 0;
+    }
+}
+
+Chunk *LightEngine::chunkAt(int x, int z)
+{
+    ChunkPos pos = World::chunkPosFor(x, z);
+    if (!m_lastChunk || pos != m_lastPos)
+    {
+        m_lastChunk = m_world->getChunk(pos);
+        m_lastPos = pos;
+        if (m_lastChunk && !m_lastChunk->isLit())
+            m_lastChunk = nullptr;
+        if (!m_lastChunk)
+            return nullptr;
+    }
+    return m_lastChunk;
+}
+
+int LightEngine::lightAt(Channel channel, const Chunk &chunk, int x, int y, int z) const
+{
+    return channel == SKY ? chunk.skyLight(x & 15, y, z & 15) : chunk.blockLight(x & 15, y, z & 15);
+}
+
+void LightEngine::setLight(Channel channel, Chunk &chunk, int x, int y, int z, int level)
+{
+    if (channel == SKY)
+        chunk.setSkyLight(x & 15, y, z & 15, level);
+    else
+        chunk.setBlockLight(x & 15, y, z & 15, level);
+    markDirty(chunk, x, y, z);
+}
+
+void LightEngine::markDirty(Chunk &chunk, int x, int y, int z)
+{
+    // The light of an air voxel shows on the faces of the six blocks around it, which may belong to the
+    // sections (or chunks) next to its own. Sections without blocks have no faces to re-mesh.
+    int sectionY = y / SECTION_SIZE;
+    int localY = y % SECTION_SIZE;
+    auto mark = [](Chunk *target, int section)
+    {
+        if (target && section >= 0 && section < SECTIONS_PER_CHUNK && target->section(section))
+            target->markSectionDirty(section);
+    };
+    mark(&chunk, sectionY);
+    if (localY == 0)
+        mark(&chunk, sectionY - 1);
+    if (localY == SECTION_SIZE - 1)
+        mark(&chunk, sectionY + 1);
+
+    ChunkPos pos = chunk.position();
+    if ((x & 15) == 0)
+        mark(m_world->getChunk({pos.x - 1, pos.z}), sectionY);
+    if ((x & 15) == CHUNK_SIZE - 1)
+        mark(m_world->getChunk({pos.x + 1, pos.z}), sectionY);
+    if ((z & 15) == 0)
+        mark(m_world->getChunk({pos.x, pos.z - 1}), sectionY);
+    if ((z & 15) == CHUNK_SIZE - 1)
+        mark(m_world->getChunk({pos.x, pos.z + 1}), sectionY);
+}
+
+void LightEngine::propagateAdd(Channel channel)
+{
+    for (; m_addHead < m_add.size(); ++m_addHead)
+    {
+        Node node = m_add[m_addHead];
+        Chunk *chunk = chunkAt(node.x, node.z);
+        if (!chunk)
+            continue;
+        int level = lightAt(channel, *chunk, node.x, node.y, node.z);
+        if (level <= 1)
+            continue;
+
+        for (int d = 0; d < 6; ++d)
+        {
+            int x = node.x + DIRECTIONS[d][0];
+            int y = node.y + DIRECTIONS[d][1];
+            int z = node.z + DIRECTIONS[d][2];
+            if (y < 0 || y >= CHUNK_HEIGHT)
+                continue;
+            Chunk *neighbour = chunkAt(x, z);
+            if (!neighbour || isOpaque(neighbour->getBlock(x & 15, y, z & 15)))
+                continue;
+
+            // Full sky light falls straight down without dimming
+            int next = channel == SKY && d == DOWN && level == MAX_LIGHT ? MAX_LIGHT : level - 1;
+            if (lightAt(channel, *neighbour, x, y, z) >= next)
+                continue;
+            setLight(channel, *neighbour, x, y, z, next);
+            m_add.push_back({x, y, z, 0});
+            ++m_stats.nodesAdded;
+        }
+    }
+    m_add.clear();
+    m_addHead = 0;
+}
+
+void LightEngine::propagateRemove(Channel channel)
+{
+    for (; m_removeHead < m_remove.size(); ++m_removeHead)
+    {
+        Node node = m_remove[m_removeHead];
+        for (int d = 0; d < 6; ++d)
+        {
+            int x = node.x + DIRECTIONS[d][0];
+            int y = node.y + DIRECTIONS[d][1];
+            int z = node.z + DIRECTIONS[d][2];
+            if (y < 0 || y >= CHUNK_HEIGHT)
+                continue;
+            Chunk *neighbour = chunkAt(x, z);
+            if (!neighbour)
+                continue;
+            int level = lightAt(channel, *neighbour, x, y, z);
+            if (level == 0)
+                continue;
+
+            // Dimmer light (or full sky light below full sky light) may have come through the cleared voxel, so
+            // clear it too; anything brighter has another source and spreads back in during the add pass
+            bool fromNode = level < node.level || (channel == SKY && d == DOWN && node.level == MAX_LIGHT && level == MAX_LIGHT);
+            if (!fromNode)
+            {
+                m_add.push_back({x, y, z, 0});
+                continue;
+            }
+            setLight(channel, *neighbour, x, y, z, 0);
+            m_remove.push_back({x, y, z, level});
+            ++m_stats.nodesRemoved;
+
+            // Light sources are cleared like any other voxel, then shine again
+            int emitted = channel == BLOCK ? lightEmission(neighbour->getBlock(x & 15, y, z & 15)) : 0;
+            if (emitted > 0)
+            {
+                setLight(channel, *neighbour, x, y, z, emitted);
+                m_add.push_back({x, y, z, 0});
+            }
+        }
+    }
+    m_remove.clear();
+    m_removeHead = 0;
+}
+
+void LightEngine::queueNeighbours(Channel channel, int x, int y, int z)
+{
+    for (const int *d : DIRECTIONS)
+    {
+        int nx = x + d[0];
+        int ny = y + d[1];
+        int nz = z + d[2];
+        if (ny < 0 || ny >= CHUNK_HEIGHT)
+            continue;
+        Chunk *neighbour = chunkAt(nx, nz);
+        if (neighbour && lightAt(channel, *neighbour, nx, ny, nz) > 1)
+            m_add.push_back({nx, ny, nz, 0});
+    }
+}
+
+void LightEngine::setBlock(World &world, int x, int y, int z, BlockID id)
+{
+    if (y < 0 || y >= CHUNK_HEIGHT || world.getBlock(x, y, z) == id)
+        return;
+    world.setBlock(x, y, z, id);
+
+    m_world = &world;
+    m_lastChunk = nullptr;
+    Chunk *chunk = chunkAt(x, z);
+    if (!chunk)
+    {
+        m_world = nullptr;
+        return; // Unloaded, so World::setBlock dropped the edit
+    }
+    for (Channel channel : {SKY, BLOCK})
+    {
+        // Clear whatever light passed through or started at the voxel, then let the surroundings (and the new
+        // block, if it shines) light it up again
+        int old = lightAt(channel, *chunk, x, y, z);
+        if (old > 0)
+        {
+            setLight(channel, *chunk, x, y, z, 0);
+            m_remove.push_back({x, y, z, old});
+            propagateRemove(channel);
+        }
+        int emitted = channel == BLOCK ? lightEmission(id) : 0;
+        if (emitted > 0)
+        {
+            setLight(channel, *chunk, x, y, z, emitted);
+            m_add.push_back({x, y, z, 0});
+        }
+        if (!isOpaque(id))
+            queueNeighbours(channel, x, y, z);
+        propagateAdd(channel);
+    }
+    m_world = nullptr;
+}
+
+void LightEngine::lightChunk(World &world, ChunkPos pos)
+{
+    Chunk *chunk = world.getChunk(pos);
+    if (!chunk)
+        return;
+    m_world = &world;
+    m_lastChunk = nullptr;
+    chunk->markLit();
+
+    // Height map: sky light reaches every voxel above the topmost opaque block of its column at full strength
+    int heights[CHUNK_SIZE][CHUNK_SIZE];
+    int top = sectionTop(*chunk);
+    int minHeight = CHUNK_HEIGHT;
+    int maxHeight = 0;
+    for (int z = 0; z < CHUNK_SIZE; ++z)
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            int y = top - 1;
+            while (y >= 0 && !isOpaque(chunk->getBlock(x, y, z)))
+                --y;
+            heights[z][x] = y + 1;
+            minHeight = std::min(minHeight, y + 1);
+            maxHeight = std::max(maxHeight, y + 1);
+        }
+
+    // Fill the columns directly; sections entirely above or below the terrain stay uniform
+    for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+    {
+        int bottom = sectionY * SECTION_SIZE;
+        NibbleArray &sky = chunk->skyLightSection(sectionY);
+        chunk->blockLightSection(sectionY).fill(0);
+        if (bottom >= maxHeight)
+            sky.fill(MAX_LIGHT);
+        else if (bottom + SECTION_SIZE <= minHeight)
+            sky.fill(0);
+        else
+            for (int y = 0; y < SECTION_SIZE; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        sky.set(ChunkSection::index(x, y, z), bottom + y >= heights[z][x] ? MAX_LIGHT : 0);
+    }
+
+    int baseX = pos.x * CHUNK_SIZE;
+    int baseZ = pos.z * CHUNK_SIZE;
+    const Chunk *neighbours[4] = {chunkAt(baseX - 1, baseZ), chunkAt(baseX + CHUNK_SIZE, baseZ), chunkAt(baseX, baseZ - 1),
+                                  chunkAt(baseX, baseZ + CHUNK_SIZE)};
+    int neighbourTop = 0;
+    for (const Chunk *neighbour : neighbours)
+        if (neighbour)
+            neighbourTop = std::max(neighbourTop, sectionTop(*neighbour));
+
+    // Sky light only has to spread sideways where a column is lit further down than a neighbouring column:
+    // below the tallest column of the chunk, or of a neighbour for the border columns
+    for (int z = 0; z < CHUNK_SIZE; ++z)
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            bool border = x == 0 || z == 0 || x == CHUNK_SIZE - 1 || z == CHUNK_SIZE - 1;
+            int limit = border ? std::max(maxHeight, neighbourTop) : maxHeight;
+            for (int y = heights[z][x]; y < limit; ++y)
+                m_add.push_back({baseX + x, y, baseZ + z, 0});
+        }
+
+    // Light already in the neighbours flows in across the borders
+    const int borderX[4] = {-1, CHUNK_SIZE, 0, 0};
+    const int borderZ[4] = {0, 0, -1, CHUNK_SIZE};
+    auto queueBorder = [&](Channel channel, int limit)
+    {
+        for (int side = 0; side < 4; ++side)
+        {
+            const Chunk *neighbour = neighbours[side];
+            if (!neighbour)
+                continue;
+            for (int i = 0; i < CHUNK_SIZE; ++i)
+                for (int y = 0; y < limit; ++y)
+                {
+                    int x = side < 2 ? borderX[side] : i;
+                    int z = side < 2 ? i : borderZ[side];
+                    if (lightAt(channel, *neighbour, baseX + x, y, baseZ + z) > 1)
+                        m_add.push_back({baseX + x, y, baseZ + z, 0});
+                }
+        }
+    };
+    queueBorder(SKY, std::max(maxHeight, neighbourTop));
+    propagateAdd(SKY);
+
+    // Block light starts at the light sources
+    for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+    {
+        if (!chunk->section(sectionY))
+            continue;
+        for (int y = sectionY * SECTION_SIZE; y < (sectionY + 1) * SECTION_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    if (int emitted = lightEmission(chunk->getBlock(x, y, z)))
+                    {
+                        chunk->setBlockLight(x, y, z, emitted);
+                        m_add.push_back({baseX + x, y, baseZ + z, 0});
+                    }
+    }
+    queueBorder(BLOCK, std::max(top, neighbourTop));
+    propagateAdd(BLOCK);
+
+    chunk->markAllDirty();
+    m_world = nullptr;
+}
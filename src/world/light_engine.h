@@ -0,0 +1,74 @@
+#ifndef LIGHT_ENGINE_H
+#define LIGHT_ENGINE_H
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For the node counters
+#include <vector>  // For the flood fill queues
+
+#include "world/world.h"
+
+// Sky and block light, stored per voxel in the chunks (Chunk::skyLight / blockLight) and baked into the
+// section meshes. Both spread by breadth-first flood fill through non-opaque blocks, losing one level per
+// step; sky light also travels straight down from the open sky without losing any.
+//
+// Edits are relit incrementally: a removal pass clears the light that came through the changed block,
+// collecting the brighter light at the edge of the cleared area, and an add pass spreads that (and any
+// new light) back in. Only the region the change reaches is visited, never the whole chunk.
+//
+// Every voxel whose light changes marks the sections whose faces it lights dirty, so they get re-meshed.
+class LightEngine
+{
+public:
+    // Lights a chunk that was just inserted into the world from scratch. Light also flows across the borders
+    // of lit neighbours in both directions, so chunks can be lit in any order. Chunks that are not lit yet
+    // are left alone (their light is the unlit default); they pull their share in when they are lit.
+    void lightChunk(World &world, ChunkPos pos);
+
+    // Changes a block (like World::setBlock) and relights what the change affects
+    void setBlock(World &world, int x, int y, int z, BlockID id);
+
+    struct Stats
+    {
+        std::uint64_t nodesAdded = 0;   // Voxels lit by the add passes
+        std::uint64_t nodesRemoved = 0; // Voxels cleared by the removal passes
+    };
+    const Stats &stats() const { return m_stats; }
+
+private:
+    enum Channel
+    {
+        SKY,
+        BLOCK
+    };
+
+    struct Node
+    {
+        int x, y, z;
+        int level; // Removal queue only: the level the voxel had before it was cleared
+    };
+
+    // Global block coordinates; nullptr for unloaded and unlit chunks. The last chunk is remembered, since the
+    // flood fill mostly steps between neighbouring voxels of one chunk.
+    Chunk *chunkAt(int x, int z);
+    int lightAt(Channel channel, const Chunk &chunk, int x, int y, int z) const;
+    void setLight(Channel channel, Chunk &chunk, int x, int y, int z, int level);
+    void markDirty(Chunk &chunk, int x, int y, int z);
+
+    void propagateRemove(Channel channel);
+    void propagateAdd(Channel channel);
+    // Queues the lit neighbours of a voxel, to spread back into it
+    void queueNeighbours(Channel channel, int x, int y, int z);
+
+    World *m_world = nullptr;
+    Chunk *m_lastChunk = nullptr;
+    ChunkPos m_lastPos;
+
+    std::vector<Node> m_add;    // FIFO, consumed from m_addHead
+    std::vector<Node> m_remove; // FIFO, consumed from m_removeHead
+    std::size_t m_addHead = 0;
+    std::size_t m_removeHead = 0;
+
+    Stats m_stats;
+};
+
+#endif
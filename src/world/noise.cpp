@@ -0,0 +1,148 @@
+#include "world/noise.h"
+
+#include <bit>   // For std::bit_cast
+#include <cmath> // For std::floor
+
+namespace
+{
+    // One lane: the reference the SIMD versions must match bit for bit
+    struct ScalarOps
+    {
+        using F = float;
+        using I = std::int32_t;
+        using M = bool;
+        static constexpr int WIDTH = 1;
+
+        static F load(const float *p) { return *p; }
+        static void store(float *p, F v) { *p = v; }
+        static F set1(float v) { return v; }
+        static I set1i(int v) { return v; }
+        static F add(F a, F b) { return a + b; }
+        static F sub(F a, F b) { return a - b; }
+        static F mul(F a, F b) { return a * b; }
+        static F floor(F v) { return std::floor(v); }
+        static I truncate(F v) { return I(v); }
+        static I andi(I a, I b) { return a & b; }
+        static I addi(I a, I b) { return a + b; }
+        template <int N>
+        static I shiftLeft(I v) { return I(std::uint32_t(v) << N); }
+        static F flipSign(F v, I signBits) { return std::bit_cast<F>(std::bit_cast<std::uint32_t>(v) ^ std::uint32_t(signBits)); }
+        static M lessThan(I v, int limit) { return v < limit; }
+        static M equal(I v, int value) { return v == value; }
+        static M orMask(M a, M b) { return a || b; }
+        static F select(M mask, F a, F b) { return mask ? a : b; }
+        static I gather(const std::int32_t *table, I index) { return table[index]; }
+    };
+
+    std::uint64_t splitMix64(std::uint64_t &state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+#if defined(SPACECRAFT_X86_SIMD)
+    SimdLevel detectOnce()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse4.1"))
+            return SimdLevel::SSE41;
+        return SimdLevel::SCALAR;
+    }
+#endif
+}
+
+#include "world/noise_kernels.h"
+
+SimdLevel detectSimdLevel()
+{
+#if defined(SPACECRAFT_X86_SIMD)
+    static const SimdLevel level = detectOnce();
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::SSE41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+PerlinNoise::PerlinNoise(std::uint64_t seed)
+{
+    for (int i = 0; i < 256; ++i)
+        m_perm[i] = i;
+
+    // Fisher-Yates shuffle driven by the seed, then duplicate so lookups of i + 1 never need wrapping
+    std::uint64_t state = seed;
+    for (int i = 255; i > 0; --i)
+    {
+        int j = int(splitMix64(state) % std::uint64_t(i + 1));
+        std::int32_t tmp = m_perm[i];
+        m_perm[i] = m_perm[j];
+        m_perm[j] = tmp;
+    }
+    for (int i = 0; i < 256; ++i)
+        m_perm[256 + i] = m_perm[i];
+}
+
+float PerlinNoise::noise2(float x, float z) const
+{
+    return perlin2<ScalarOps>(m_perm, x, z);
+}
+
+float PerlinNoise::noise3(float x, float y, float z) const
+{
+    return perlin3<ScalarOps>(m_perm, x, y, z);
+}
+
+void PerlinNoise::fbm2(const float *x, const float *z, float *out, int count, const FbmParams &params, SimdLevel level) const
+{
+#if defined(SPACECRAFT_X86_SIMD)
+    if (level == SimdLevel::AVX2)
+        return noise_detail::fbm2Avx2(m_perm, x, z, out, count, params);
+    if (level == SimdLevel::SSE41)
+        return noise_detail::fbm2Sse41(m_perm, x, z, out, count, params);
+#else
+    (void)level;
+#endif
+    noise_detail::fbm2Scalar(m_perm, x, z, out, count, params);
+}
+
+void PerlinNoise::fbm3(const float *x, const float *y, const float *z, float *out, int count, const FbmParams &params,
+                       SimdLevel level) const
+{
+#if defined(SPACECRAFT_X86_SIMD)
+    if (level == SimdLevel::AVX2)
+        return noise_detail::fbm3Avx2(m_perm, x, y, z, out, count, params);
+    if (level == SimdLevel::SSE41)
+        return noise_detail::fbm3Sse41(m_perm, x, y, z, out, count, params);
+#else
+    (void)level;
+#endif
+    noise_detail::fbm3Scalar(m_perm, x, y, z, out, count, params);
+}
+
+void noise_detail::fbm2Scalar(const std::int32_t *perm, const float *x, const float *z, float *out, int count,
+                              const FbmParams &params)
+{
+    fbm2Batch<ScalarOps>(perm, x, z, out, count, params);
+}
+
+void noise_detail::fbm3Scalar(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out,
+                              int count, const FbmParams &params)
+{
+    fbm3Batch<ScalarOps>(perm, x, y, z, out, count, params);
+}
@@ -0,0 +1,57 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <cstdint> // For std::uint64_t, std::int32_t
+
+// Instruction sets the batched noise functions can use. Every level produces bit-identical results,
+// the kernels perform the same float operations in the same order (and are compiled without FMA contraction).
+enum class SimdLevel
+{
+    SCALAR,
+    SSE41, // 4 lanes, the 8-point batch runs as two halves
+    AVX2,  // 8 lanes
+};
+
+// Best level the running CPU supports (AVX2 > SSE4.1 > scalar)
+SimdLevel detectSimdLevel();
+const char *simdLevelName(SimdLevel level);
+
+// Fractal Brownian motion: sum of `octaves` noise layers, each at `lacunarity` times the frequency
+// and `gain` times the amplitude of the previous one
+struct FbmParams
+{
+    int octaves = 4;
+    float frequency = 1.0f / 64.0f;
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+};
+
+// Seedable Perlin noise. The batched functions evaluate `count` points (any count, ideally a multiple of 8)
+// with the requested instruction set; the scalar functions evaluate one point.
+class PerlinNoise
+{
+public:
+    explicit PerlinNoise(std::uint64_t seed);
+
+    float noise2(float x, float z) const;
+    float noise3(float x, float y, float z) const;
+
+    void fbm2(const float *x, const float *z, float *out, int count, const FbmParams &params, SimdLevel level) const;
+    void fbm3(const float *x, const float *y, const float *z, float *out, int count, const FbmParams &params, SimdLevel level) const;
+
+private:
+    alignas(32) std::int32_t m_perm[512]; // Shuffled 0..255 twice, int32 so AVX2 can gather from it
+};
+
+// Implementation entry points of the batched kernels, one set per instruction set (noise*.cpp)
+namespace noise_detail
+{
+    void fbm2Scalar(const std::int32_t *perm, const float *x, const float *z, float *out, int count, const FbmParams &params);
+    void fbm3Scalar(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out, int count, const FbmParams &params);
+    void fbm2Sse41(const std::int32_t *perm, const float *x, const float *z, float *out, int count, const FbmParams &params);
+    void fbm3Sse41(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out, int count, const FbmParams &params);
+    void fbm2Avx2(const std::int32_t *perm, const float *x, const float *z, float *out, int count, const FbmParams &params);
+    void fbm3Avx2(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out, int count, const FbmParams &params);
+}
+
+#endif
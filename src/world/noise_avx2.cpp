@@ -0,0 +1,50 @@
+// Compiled with -mavx2 (see CMakeLists.txt) and only called after detectSimdLevel() checked the CPU
+#include <immintrin.h> // For AVX2 intrinsics
+
+#include "world/noise.h"
+
+namespace
+{
+    // Eight lanes per register: one batch of columns per call, permutation lookups use hardware gathers
+    struct Avx2Ops
+    {
+        using F = __m256;
+        using I = __m256i;
+        using M = __m256i;
+        static constexpr int WIDTH = 8;
+
+        static F load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, F v) { _mm256_storeu_ps(p, v); }
+        static F set1(float v) { return _mm256_set1_ps(v); }
+        static I set1i(int v) { return _mm256_set1_epi32(v); }
+        static F add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F floor(F v) { return _mm256_floor_ps(v); }
+        static I truncate(F v) { return _mm256_cvttps_epi32(v); }
+        static I andi(I a, I b) { return _mm256_and_si256(a, b); }
+        static I addi(I a, I b) { return _mm256_add_epi32(a, b); }
+        template <int N>
+        static I shiftLeft(I v) { return _mm256_slli_epi32(v, N); }
+        static F flipSign(F v, I signBits) { return _mm256_xor_ps(v, _mm256_castsi256_ps(signBits)); }
+        static M lessThan(I v, int limit) { return _mm256_cmpgt_epi32(_mm256_set1_epi32(limit), v); }
+        static M equal(I v, int value) { return _mm256_cmpeq_epi32(v, _mm256_set1_epi32(value)); }
+        static M orMask(M a, M b) { return _mm256_or_si256(a, b); }
+        static F select(M mask, F a, F b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+        static I gather(const std::int32_t *table, I index) { return _mm256_i32gather_epi32(table, index, 4); }
+    };
+}
+
+#include "world/noise_kernels.h"
+
+void noise_detail::fbm2Avx2(const std::int32_t *perm, const float *x, const float *z, float *out, int count,
+                            const FbmParams &params)
+{
+    fbm2Batch<Avx2Ops>(perm, x, z, out, count, params);
+}
+
+void noise_detail::fbm3Avx2(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out,
+                            int count, const FbmParams &params)
+{
+    fbm3Batch<Avx2Ops>(perm, x, y, z, out, count, params);
+}
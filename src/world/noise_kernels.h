@@ -0,0 +1,207 @@
+#ifndef NOISE_KERNELS_H
+#define NOISE_KERNELS_H
+
+// Perlin noise written once against a small "lane ops" interface and instantiated per instruction set
+// (scalar in noise.cpp, SSE4.1 in noise_sse41.cpp, AVX2 in noise_avx2.cpp). Because every instantiation
+// runs the same sequence of IEEE operations (no FMA, negation as a sign flip, floor and truncation only
+// on integral values) the results are bit-identical whatever the lane width.
+//
+// Only include this from the noise translation units, after defining the Ops type. Everything lives in an
+// anonymous namespace so the per-ISA copies never get merged by the linker.
+//
+// Ops must provide: F, I, WIDTH, load, store, set1, set1i, add, sub, mul, floor, truncate, andi, addi,
+// shiftLeft<N>, flipSign(F, I signBits), lessThan(I, int) -> mask, equal(I, int) -> mask, orMask,
+// select(mask, a, b) -> mask ? a : b, gather(table, I).
+
+#include <cstdint> // For std::int32_t
+
+#include "world/noise.h"
+
+namespace
+{
+    template <class Ops>
+    inline typename Ops::F fade(typename Ops::F t)
+    {
+        // 6t^5 - 15t^4 + 10t^3
+        using F = typename Ops::F;
+        F t3 = Ops::mul(Ops::mul(t, t), t);
+        F inner = Ops::add(Ops::mul(t, Ops::sub(Ops::mul(t, Ops::set1(6.0f)), Ops::set1(15.0f))), Ops::set1(10.0f));
+        return Ops::mul(t3, inner);
+    }
+
+    template <class Ops>
+    inline typename Ops::F lerp(typename Ops::F t, typename Ops::F a, typename Ops::F b)
+    {
+        return Ops::add(a, Ops::mul(t, Ops::sub(b, a)));
+    }
+
+    // Negates v in the lanes where (hash & bit) is set; bit must be 1 << BIT
+    template <class Ops, int BIT>
+    inline typename Ops::F negateIf(typename Ops::I hash, typename Ops::F v)
+    {
+        return Ops::flipSign(v, Ops::template shiftLeft<31 - BIT>(Ops::andi(hash, Ops::set1i(1 << BIT))));
+    }
+
+    // 8 gradient directions (±1, ±2), (±2, ±1), same as Gustavson's noise1234
+    template <class Ops>
+    inline typename Ops::F grad2(typename Ops::I hash, typename Ops::F x, typename Ops::F z)
+    {
+        using F = typename Ops::F;
+        typename Ops::I h = Ops::andi(hash, Ops::set1i(7));
+        auto low = Ops::lessThan(h, 4);
+        F u = Ops::select(low, x, z);
+        F v = Ops::select(low, z, x);
+        return Ops::add(negateIf<Ops, 0>(h, u), negateIf<Ops, 1>(h, Ops::add(v, v)));
+    }
+
+    // The 12 cube edge directions of improved Perlin noise (hashed over 16 entries)
+    template <class Ops>
+    inline typename Ops::F grad3(typename Ops::I hash, typename Ops::F x, typename Ops::F y, typename Ops::F z)
+    {
+        using F = typename Ops::F;
+        typename Ops::I h = Ops::andi(hash, Ops::set1i(15));
+        F u = Ops::select(Ops::lessThan(h, 8), x, y);
+        F v = Ops::select(Ops::lessThan(h, 4), y, Ops::select(Ops::orMask(Ops::equal(h, 12), Ops::equal(h, 14)), x, z));
+        return Ops::add(negateIf<Ops, 0>(h, u), negateIf<Ops, 1>(h, v));
+    }
+
+    template <class Ops>
+    inline typename Ops::F perlin2(const std::int32_t *perm, typename Ops::F x, typename Ops::F z)
+    {
+        using F = typename Ops::F;
+        using I = typename Ops::I;
+        F one = Ops::set1(1.0f);
+        I mask = Ops::set1i(255);
+        I oneI = Ops::set1i(1);
+
+        F x0 = Ops::floor(x);
+        F z0 = Ops::floor(z);
+        I xi = Ops::andi(Ops::truncate(x0), mask);
+        I zi = Ops::andi(Ops::truncate(z0), mask);
+        F fx = Ops::sub(x, x0);
+        F fz = Ops::sub(z, z0);
+        F u = fade<Ops>(fx);
+        F v = fade<Ops>(fz);
+
+        I a = Ops::addi(Ops::gather(perm, xi), zi);
+        I b = Ops::addi(Ops::gather(perm, Ops::addi(xi, oneI)), zi);
+        F fx1 = Ops::sub(fx, one);
+        F fz1 = Ops::sub(fz, one);
+
+        F n00 = grad2<Ops>(Ops::gather(perm, a), fx, fz);
+        F n10 = grad2<Ops>(Ops::gather(perm, b), fx1, fz);
+        F n01 = grad2<Ops>(Ops::gather(perm, Ops::addi(a, oneI)), fx, fz1);
+        F n11 = grad2<Ops>(Ops::gather(perm, Ops::addi(b, oneI)), fx1, fz1);
+
+        // Gradients of length ~2 put the raw result in about [-2, 2], scale to about [-1, 1]
+        return Ops::mul(lerp<Ops>(v, lerp<Ops>(u, n00, n10), lerp<Ops>(u, n01, n11)), Ops::set1(0.5f));
+    }
+
+    template <class Ops>
+    inline typename Ops::F perlin3(const std::int32_t *perm, typename Ops::F x, typename Ops::F y, typename Ops::F z)
+    {
+        using F = typename Ops::F;
+        using I = typename Ops::I;
+        F one = Ops::set1(1.0f);
+        I mask = Ops::set1i(255);
+        I oneI = Ops::set1i(1);
+
+        F x0 = Ops::floor(x);
+        F y0 = Ops::floor(y);
+        F z0 = Ops::floor(z);
+        I xi = Ops::andi(Ops::truncate(x0), mask);
+        I yi = Ops::andi(Ops::truncate(y0), mask);
+        I zi = Ops::andi(Ops::truncate(z0), mask);
+        F fx = Ops::sub(x, x0);
+        F fy = Ops::sub(y, y0);
+        F fz = Ops::sub(z, z0);
+        F u = fade<Ops>(fx);
+        F v = fade<Ops>(fy);
+        F w = fade<Ops>(fz);
+
+        I a = Ops::addi(Ops::gather(perm, xi), yi);
+        I b = Ops::addi(Ops::gather(perm, Ops::addi(xi, oneI)), yi);
+        I aa = Ops::addi(Ops::gather(perm, a), zi);
+        I ab = Ops::addi(Ops::gather(perm, Ops::addi(a, oneI)), zi);
+        I ba = Ops::addi(Ops::gather(perm, b), zi);
+        I bb = Ops::addi(Ops::gather(perm, Ops::addi(b, oneI)), zi);
+        F fx1 = Ops::sub(fx, one);
+        F fy1 = Ops::sub(fy, one);
+        F fz1 = Ops::sub(fz, one);
+
+        F n000 = grad3<Ops>(Ops::gather(perm, aa), fx, fy, fz);
+        F n100 = grad3<Ops>(Ops::gather(perm, ba), fx1, fy, fz);
+        F n010 = grad3<Ops>(Ops::gather(perm, ab), fx, fy1, fz);
+        F n110 = grad3<Ops>(Ops::gather(perm, bb), fx1, fy1, fz);
+        F n001 = grad3<Ops>(Ops::gather(perm, Ops::addi(aa, oneI)), fx, fy, fz1);
+        F n101 = grad3<Ops>(Ops::gather(perm, Ops::addi(ba, oneI)), fx1, fy, fz1);
+        F n011 = grad3<Ops>(Ops::gather(perm, Ops::addi(ab, oneI)), fx, fy1, fz1);
+        F n111 = grad3<Ops>(Ops::gather(perm, Ops::addi(bb, oneI)), fx1, fy1, fz1);
+
+        F near = lerp<Ops>(v, lerp<Ops>(u, n000, n100), lerp<Ops>(u, n010, n110));
+        F far = lerp<Ops>(v, lerp<Ops>(u, n001, n101), lerp<Ops>(u, n011, n111));
+        return lerp<Ops>(w, near, far);
+    }
+
+    // Shifts each octave so layers do not line up at the origin
+    constexpr float OCTAVE_OFFSET = 71.37f;
+
+    template <class Ops>
+    void fbm2Batch(const std::int32_t *perm, const float *x, const float *z, float *out, int count, const FbmParams &params)
+    {
+        using F = typename Ops::F;
+        int i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+        {
+            F px = Ops::load(x + i);
+            F pz = Ops::load(z + i);
+            F sum = Ops::set1(0.0f);
+            float frequency = params.frequency;
+            float amplitude = 1.0f;
+            for (int octave = 0; octave < params.octaves; ++octave)
+            {
+                F f = Ops::set1(frequency);
+                F offset = Ops::set1(float(octave) * OCTAVE_OFFSET);
+                F n = perlin2<Ops>(perm, Ops::add(Ops::mul(px, f), offset), Ops::add(Ops::mul(pz, f), offset));
+                sum = Ops::add(sum, Ops::mul(n, Ops::set1(amplitude)));
+                frequency *= params.lacunarity;
+                amplitude *= params.gain;
+            }
+            Ops::store(out + i, sum);
+        }
+        if (i < count)
+            noise_detail::fbm2Scalar(perm, x + i, z + i, out + i, count - i, params);
+    }
+
+    template <class Ops>
+    void fbm3Batch(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out, int count,
+                   const FbmParams &params)
+    {
+        using F = typename Ops::F;
+        int i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+        {
+            F px = Ops::load(x + i);
+            F py = Ops::load(y + i);
+            F pz = Ops::load(z + i);
+            F sum = Ops::set1(0.0f);
+            float frequency = params.frequency;
+            float amplitude = 1.0f;
+            for (int octave = 0; octave < params.octaves; ++octave)
+            {
+                F f = Ops::set1(frequency);
+                F offset = Ops::set1(float(octave) * OCTAVE_OFFSET);
+                F n = perlin3<Ops>(perm, Ops::add(Ops::mul(px, f), offset), Ops::add(Ops::mul(py, f), offset),
+                                   Ops::add(Ops::mul(pz, f), offset));
+                sum = Ops::add(sum, Ops::mul(n, Ops::set1(amplitude)));
+                frequency *= params.lacunarity;
+                amplitude *= params.gain;
+            }
+            Ops::store(out + i, sum);
+        }
+        if (i < count)
+            noise_detail::fbm3Scalar(perm, x + i, y + i, z + i, out + i, count - i, params);
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+// Compiled with -msse4.1 (see CMakeLists.txt) and only called after detectSimdLevel() checked the CPU
+#include <smmintrin.h> // For SSE4.1 intrinsics
+
+#include "world/noise.h"
+
+namespace
+{
+    // Four lanes per register; SSE has no gather, so table lookups go through the lanes one by one
+    struct Sse41Ops
+    {
+        using F = __m128;
+        using I = __m128i;
+        using M = __m128i;
+        static constexpr int WIDTH = 4;
+
+        static F load(const float *p) { return _mm_loadu_ps(p); }
+        static void store(float *p, F v) { _mm_storeu_ps(p, v); }
+        static F set1(float v) { return _mm_set1_ps(v); }
+        static I set1i(int v) { return _mm_set1_epi32(v); }
+        static F add(F a, F b) { return _mm_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F floor(F v) { return _mm_floor_ps(v); }
+        static I truncate(F v) { return _mm_cvttps_epi32(v); }
+        static I andi(I a, I b) { return _mm_and_si128(a, b); }
+        static I addi(I a, I b) { return _mm_add_epi32(a, b); }
+        template <int N>
+        static I shiftLeft(I v) { return _mm_slli_epi32(v, N); }
+        static F flipSign(F v, I signBits) { return _mm_xor_ps(v, _mm_castsi128_ps(signBits)); }
+        static M lessThan(I v, int limit) { return _mm_cmplt_epi32(v, _mm_set1_epi32(limit)); }
+        static M equal(I v, int value) { return _mm_cmpeq_epi32(v, _mm_set1_epi32(value)); }
+        static M orMask(M a, M b) { return _mm_or_si128(a, b); }
+        static F select(M mask, F a, F b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(mask)); }
+        static I gather(const std::int32_t *table, I index)
+        {
+            return _mm_setr_epi32(table[_mm_cvtsi128_si32(index)], table[_mm_extract_epi32(index, 1)],
+                                  table[_mm_extract_epi32(index, 2)], table[_mm_extract_epi32(index, 3)]);
+        }
+    };
+}
+
+#include "world/noise_kernels.h"
+
+void noise_detail::fbm2Sse41(const std::int32_t *perm, const float *x, const float *z, float *out, int count,
+                             const FbmParams &params)
+{
+    fbm2Batch<Sse41Ops>(perm, x, z, out, count, params);
+}
+
+void noise_detail::fbm3Sse41(const std::int32_t *perm, const float *x, const float *y, const float *z, float *out,
+                             int count, const FbmParams &params)
+{
+    fbm3Batch<Sse41Ops>(perm, x, y, z, out, count, params);
+}
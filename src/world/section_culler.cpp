@@ -0,0 +1,204 @@
+#include "world/section_culler.h"
+
+#include <bit> // For std::popcount, std::countr_zero, std::bit_width
+
+namespace
+{
+    constexpr int REGION_COLUMNS = CULL_REGION_SIZE * CULL_REGION_SIZE;
+    constexpr float REGION_BLOCKS = float(CULL_REGION_SIZE * CHUNK_SIZE);
+
+    // Vertical extent in blocks of the sections set in mask (not 0)
+    float lowestY(std::uint16_t mask) { return float(std::countr_zero(mask) * SECTION_SIZE); }
+    float highestY(std::uint16_t mask) { return float(std::bit_width(unsigned(mask)) * SECTION_SIZE); }
+}
+
+std::uint64_t SectionCuller::regionKey(int x, int z)
+{
+    return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(z);
+}
+
+Aabb SectionCuller::columnBounds(ChunkPos chunk, std::uint16_t sections)
+{
+    Vec3 min(float(chunk.x * CHUNK_SIZE), lowestY(sections), float(chunk.z * CHUNK_SIZE));
+    return {min, Vec3(min.x + float(CHUNK_SIZE), highestY(sections), min.z + float(CHUNK_SIZE))};
+}
+
+void SectionCuller::add(ChunkPos chunk, int sectionY)
+{
+    int x = floorDiv(chunk.x, CULL_REGION_SIZE), z = floorDiv(chunk.z, CULL_REGION_SIZE);
+    auto [it, inserted] = m_regions.try_emplace(regionKey(x, z));
+    Region &region = it->second;
+    if (inserted)
+    {
+        region.x = x;
+        region.z = z;
+        m_regionsChanged = true;
+    }
+
+    std::uint16_t &column = region.columns[(chunk.z - z * CULL_REGION_SIZE) * CULL_REGION_SIZE + (chunk.x - x * CULL_REGION_SIZE)];
+    std::uint16_t bit = std::uint16_t(1u << sectionY);
+    if (column & bit)
+        return;
+    if (!column)
+        ++region.occupiedColumns;
+    column |= bit;
+    ++region.sectionCount;
+    ++m_sectionCount;
+    updateRegion(region);
+}
+
+void SectionCuller::remove(ChunkPos chunk, int sectionY)
+{
+    int x = floorDiv(chunk.x, CULL_REGION_SIZE), z = floorDiv(chunk.z, CULL_REGION_SIZE);
+    auto it = m_regions.find(regionKey(x, z));
+    if (it == m_regions.end())
+        return;
+    Region &region = it->second;
+
+    std::uint16_t &column = region.columns[(chunk.z - z * CULL_REGION_SIZE) * CULL_REGION_SIZE + (chunk.x - x * CULL_REGION_SIZE)];
+    std::uint16_t bit = std::uint16_t(1u << sectionY);
+    if (!(column & bit))
+        return;
+    column &= std::uint16_t(~bit);
+    if (!column)
+        --region.occupiedColumns;
+    --region.sectionCount;
+    --m_sectionCount;
+
+    if (region.sectionCount == 0)
+    {
+        m_regions.erase(it);
+        m_regionsChanged = true;
+    }
+    else
+        updateRegion(region);
+}
+
+void SectionCuller::updateRegion(Region &region)
+{
+    std::uint16_t sections = 0;
+    for (std::uint16_t column : region.columns)
+        sections |= column;
+    if (sections != region.sections)
+    {
+        region.sections = sections;
+        m_regionsChanged = true; // The region box changed height
+    }
+}
+
+void SectionCuller::cull(const Frustum &frustum, std::vector<VisibleSection> &visible, CullStats &stats)
+{
+    visible.clear();
+    stats = {};
+
+    if (m_regionsChanged)
+    {
+        m_regionsChanged = false;
+        m_regionOrder.clear();
+        m_regionBoxes.clear();
+        for (const auto &[key, region] : m_regions)
+        {
+            Vec3 min(float(region.x) * REGION_BLOCKS, lowestY(region.sections), float(region.z) * REGION_BLOCKS);
+            m_regionOrder.push_back(&region);
+            m_regionBoxes.push({min, Vec3(min.x + REGION_BLOCKS, highestY(region.sections), min.z + REGION_BLOCKS)});
+        }
+    }
+
+    m_regionResults.resize(m_regionOrder.size());
+    frustum.classify(m_regionBoxes, m_regionResults.data());
+    stats.regionsTested = m_regionOrder.size();
+
+    for (std::size_t i = 0; i < m_regionOrder.size(); ++i)
+    {
+        const Region &region = *m_regionOrder[i];
+        if (m_regionResults[i] == CullResult::OUTSIDE)
+        {
+            ++stats.regionsCulled;
+            stats.chunksCulled += std::size_t(region.occupiedColumns);
+            stats.sectionsCulled += std::size_t(region.sectionCount);
+        }
+        else if (m_regionResults[i] == CullResult::INSIDE)
+            acceptRegion(region, visible);
+        else
+            cullRegion(frustum, region, visible, stats);
+    }
+    stats.sectionsVisible = visible.size();
+}
+
+void SectionCuller::acceptRegion(const Region &region, std::vector<VisibleSection> &visible) const
+{
+    for (int i = 0; i < REGION_COLUMNS; ++i)
+    {
+        ChunkPos chunk{region.x * CULL_REGION_SIZE + i % CULL_REGION_SIZE, region.z * CULL_REGION_SIZE + i / CULL_REGION_SIZE};
+        for (unsigned mask = region.columns[std::size_t(i)]; mask; mask &= mask - 1)
+            visible.push_back({chunk, std::countr_zero(mask)});
+    }
+}
+
+void SectionCuller::cullRegion(const Frustum &frustum, const Region &region, std::vector<VisibleSection> &visible, CullStats &stats)
+{
+    // Columns first
+    m_boxes.clear();
+    m_columns.clear();
+    for (int i = 0; i < REGION_COLUMNS; ++i)
+    {
+        std::uint16_t sections = region.columns[std::size_t(i)];
+        if (!sections)
+            continue;
+        ChunkPos chunk{region.x * CULL_REGION_SIZE + i % CULL_REGION_SIZE, region.z * CULL_REGION_SIZE + i / CULL_REGION_SIZE};
+        m_boxes.push(columnBounds(chunk, sections));
+        m_columns.push_back({chunk, sections});
+    }
+    m_columnResults.resize(m_columns.size());
+    frustum.classify(m_boxes, m_columnResults.data());
+    stats.chunksTested += m_columns.size();
+
+    // Then the sections of every column crossing the frustum, all in one batch
+    m_boxes.clear();
+    m_candidates.clear();
+    for (std::size_t c = 0; c < m_columns.size(); ++c)
+    {
+        const ColumnRef &column = m_columns[c];
+        if (m_columnResults[c] == CullResult::OUTSIDE)
+        {
+            ++stats.chunksCulled;
+            stats.sectionsCulled += std::size_t(std::popcount(column.sections));
+            continue;
+        }
+        for (unsigned bits = column.sections; bits; bits &= bits - 1)
+        {
+            int sectionY = std::countr_zero(bits);
+            if (m_columnResults[c] == CullResult::INSIDE)
+            {
+                visible.push_back({column.chunk, sectionY});
+                continue;
+            }
+            Vec3 min(float(column.chunk.x * CHUNK_SIZE), float(sectionY * SECTION_SIZE), float(column.chunk.z * CHUNK_SIZE));
+            m_boxes.push({min, min + Vec3(float(CHUNK_SIZE), float(SECTION_SIZE), float(CHUNK_SIZE))});
+            m_candidates.push_back({column.chunk, sectionY});
+        }
+    }
+    m_results.resize(m_candidates.size());
+    frustum.classify(m_boxes, m_results.data());
+    stats.sectionsTested += m_candidates.size();
+
+    // Candidates are grouped by column; a column crossing the frustum counts as culled when none of its sections made it
+    bool columnVisible = false;
+    for (std::size_t i = 0; i < m_candidates.size(); ++i)
+    {
+        if (i > 0 && m_candidates[i].chunk != m_candidates[i - 1].chunk)
+        {
+            stats.chunksCulled += columnVisible ? 0 : 1;
+            columnVisible = false;
+        }
+        if (m_results[i] == CullResult::OUTSIDE)
+            ++stats.sectionsCulled;
+        else
+        {
+            visible.push_back(m_candidates[i]);
+            columnVisible = true;
+        }
+    }
+    if (!m_candidates.empty())
+        stats.chunksCulled += columnVisible ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#ifndef SECTION_CULLER_H
+#define SECTION_CULLER_H
+
+#include <array>         // For the per-region column masks
+#include <cstdint>       // For section masks and region keys
+#include <unordered_map> // For the regions
+#include <vector>        // For results and scratch lists
+
+#include "core/frustum.h"
+#include "world/chunk.h"
+
+// Which chunk sections (the unit the renderer draws) lie in the view frustum, tested top down:
+// regions of CULL_REGION_SIZE x CULL_REGION_SIZE chunk columns, then the columns of a region that
+// crosses the frustum, then the sections of a column that crosses it. Anything entirely outside is
+// dropped with all its contents and anything entirely inside is accepted without further tests.
+// Every level is tested in SIMD batches of four boxes (Frustum::classify).
+//
+// Only which sections exist is stored (one bit each), boxes follow from the grid and are snug in y:
+// a column spans from its lowest to its highest section, a region from its lowest to highest.
+constexpr int CULL_REGION_SIZE = 8; // Chunk columns along x and z
+
+struct CullStats
+{
+    std::size_t regionsTested = 0;
+    std::size_t regionsCulled = 0;
+    std::size_t chunksTested = 0;    // Columns tested one by one (in regions crossing the frustum)
+    std::size_t chunksCulled = 0;    // Columns with sections that were not drawn, by any level
+    std::size_t sectionsTested = 0;  // Sections tested one by one (in columns crossing the frustum)
+    std::size_t sectionsCulled = 0;  // By any level
+    std::size_t sectionsVisible = 0; // Passed on for drawing
+};
+
+struct VisibleSection
+{
+    ChunkPos chunk;
+    int sectionY = 0;
+};
+
+class SectionCuller
+{
+public:
+    // Marks a section as drawable (it has a mesh) or not
+    void add(ChunkPos chunk, int sectionY);
+    void remove(ChunkPos chunk, int sectionY);
+
+    std::size_t sectionCount() const { return m_sectionCount; }
+
+    // Replaces visible with the sections inside the frustum, region by region
+    void cull(const Frustum &frustum, std::vector<VisibleSection> &visible, CullStats &stats);
+
+private:
+    struct Region
+    {
+        int x = 0, z = 0;                                                         // Region coordinates
+        std::array<std::uint16_t, CULL_REGION_SIZE * CULL_REGION_SIZE> columns{}; // Section bits per column, x fastest
+        std::uint16_t sections = 0;                                               // Union of the column masks
+        int occupiedColumns = 0;
+        int sectionCount = 0;
+    };
+
+    struct ColumnRef
+    {
+        ChunkPos chunk;
+        std::uint16_t sections = 0;
+    };
+
+    static std::uint64_t regionKey(int x, int z);
+    static Aabb columnBounds(ChunkPos chunk, std::uint16_t sections);
+    void updateRegion(Region &region);
+    void acceptRegion(const Region &region, std::vector<VisibleSection> &visible) const;
+    void cullRegion(const Frustum &frustum, const Region &region, std::vector<VisibleSection> &visible, CullStats &stats);
+
+    std::unordered_map<std::uint64_t, Region> m_regions;
+    std::size_t m_sectionCount = 0;
+
+    // Region boxes in m_regionOrder order, rebuilt when a region was added, removed or changed height
+    bool m_regionsChanged = false;
+    std::vector<const Region *> m_regionOrder;
+    AabbList m_regionBoxes;
+
+    // Scratch, kept to avoid allocating every frame
+    std::vector<CullResult> m_regionResults;
+    std::vector<ColumnRef> m_columns;
+    std::vector<CullResult> m_columnResults;
+    std::vector<VisibleSection> m_candidates;
+    AabbList m_boxes;
+    std::vector<CullResult> m_results;
+};
+
+#endif
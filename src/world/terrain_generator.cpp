@@ -0,0 +1,184 @@
+#include "world/terrain_generator.h"
+
+#include <algorithm> // For std::max, std::max_element, std::clamp
+#include <cmath>     // For std::fabs
+#include <vector>    // For the cave sample buffers
+
+namespace
+{
+    // Height profile and surface blocks of one biome, centred at `center` on the biome noise axis
+    struct BiomeProfile
+    {
+        float center;
+        float baseHeight;
+        float amplitude;
+        BlockID top;
+        BlockID filler;
+    };
+
+    const BiomeProfile BIOMES[int(Biome::COUNT)] = {
+        {-0.45f, 64.0f, 6.0f, Blocks::SAND, Blocks::SANDSTONE},  // DESERT
+        {-0.15f, 66.0f, 10.0f, Blocks::GRASS, Blocks::DIRT},     // PLAINS
+        {0.15f, 74.0f, 28.0f, Blocks::GRASS, Blocks::DIRT},      // HILLS
+        {0.45f, 92.0f, 64.0f, Blocks::STONE, Blocks::STONE},     // MOUNTAINS
+    };
+    constexpr float BIOME_BLEND = 0.35f; // Half width of each biome's weight ramp on the biome axis
+
+    constexpr FbmParams CONTINENT_NOISE = {3, 1.0f / 512.0f, 2.0f, 0.5f};
+    constexpr FbmParams DETAIL_NOISE = {5, 1.0f / 96.0f, 2.0f, 0.5f};
+    constexpr FbmParams BIOME_NOISE = {2, 1.0f / 384.0f, 2.0f, 0.5f};
+    constexpr FbmParams CAVE_NOISE = {2, 1.0f / 48.0f, 2.0f, 0.4f};
+
+    constexpr float CONTINENT_HEIGHT = 24.0f; // Blocks the continent field raises or lowers all biomes
+    constexpr float BIOME_SCALE = 1.5f;       // Stretches the biome field so every biome actually shows up
+    constexpr float CAVE_Y_STRETCH = 1.6f;    // Squashes caves vertically so they run mostly sideways
+    constexpr float CAVE_RADIUS_SQ = 0.012f;  // Caves are where both cave fields are within this of zero
+    constexpr int SNOW_LINE = 130;            // Mountain tops above this are capped with ice
+    constexpr int GOLD_MAX_Y = 40;
+    constexpr std::uint32_t GOLD_CHANCE = 0xFFFFFFFFu / 200; // One in 200 stone blocks below GOLD_MAX_Y
+    constexpr int FILLER_DEPTH = 3;
+
+    std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream)
+    {
+        std::uint64_t z = seed + stream * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Position hash for scattered features like ores (pure integer maths, identical on every path)
+    std::uint32_t hashBlock(std::uint64_t seed, int x, int y, int z)
+    {
+        std::uint64_t h = seed ^ (std::uint64_t(std::uint32_t(x)) * 0x8DA6B343u) ^
+                          (std::uint64_t(std::uint32_t(y)) * 0xD8163841u) ^ (std::uint64_t(std::uint32_t(z)) * 0xCB1AB31Fu);
+        return std::uint32_t(mixSeed(h, 1) >> 32);
+    }
+}
+
+TerrainGenerator::TerrainGenerator(std::uint64_t seed, SimdLevel level)
+    : m_seed(seed), m_level(level), m_continent(mixSeed(seed, 1)), m_detail(mixSeed(seed, 2)), m_biome(mixSeed(seed, 3)),
+      m_caveA(mixSeed(seed, 4)), m_caveB(mixSeed(seed, 5))
+{
+}
+
+std::unique_ptr<Chunk> TerrainGenerator::generate(ChunkPos pos) const
+{
+    auto chunk = std::make_unique<Chunk>(pos);
+    generate(*chunk);
+    return chunk;
+}
+
+void TerrainGenerator::generate(Chunk &chunk) const
+{
+    Columns columns;
+    generateColumns(chunk.position(), columns);
+    placeBlocks(chunk, columns);
+    chunk.markAllDirty();
+    chunk.markSaved(); // Generated terrain can always be generated again, only edits need saving
+}
+
+void TerrainGenerator::generateColumns(ChunkPos pos, Columns &columns) const
+{
+    constexpr int COUNT = CHUNK_SIZE * CHUNK_SIZE;
+    alignas(32) float xs[COUNT];
+    alignas(32) float zs[COUNT];
+    for (int z = 0; z < CHUNK_SIZE; ++z)
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            xs[z * CHUNK_SIZE + x] = float(pos.x * CHUNK_SIZE + x);
+            zs[z * CHUNK_SIZE + x] = float(pos.z * CHUNK_SIZE + z);
+        }
+
+    alignas(32) float continent[COUNT];
+    alignas(32) float detail[COUNT];
+    alignas(32) float biome[COUNT];
+    m_continent.fbm2(xs, zs, continent, COUNT, CONTINENT_NOISE, m_level);
+    m_detail.fbm2(xs, zs, detail, COUNT, DETAIL_NOISE, m_level);
+    m_biome.fbm2(xs, zs, biome, COUNT, BIOME_NOISE, m_level);
+
+    const BiomeProfile &first = BIOMES[0];
+    const BiomeProfile &last = BIOMES[int(Biome::COUNT) - 1];
+    for (int i = 0; i < COUNT; ++i)
+    {
+        // Blend the height profiles of the biomes around this point so borders slope instead of stepping
+        float b = std::clamp(biome[i] * BIOME_SCALE, first.center, last.center);
+        float height = 0.0f;
+        float weightSum = 0.0f;
+        float bestWeight = 0.0f;
+        int best = 0;
+        for (int k = 0; k < int(Biome::COUNT); ++k)
+        {
+            float weight = std::max(0.0f, 1.0f - std::fabs(b - BIOMES[k].center) / BIOME_BLEND);
+            height += weight * (BIOMES[k].baseHeight + BIOMES[k].amplitude * detail[i]);
+            weightSum += weight;
+            if (weight > bestWeight)
+            {
+                bestWeight = weight;
+                best = k;
+            }
+        }
+        height = height / weightSum + continent[i] * CONTINENT_HEIGHT;
+
+        columns.height[i] = std::clamp(int(height), 1, CHUNK_HEIGHT - 2);
+        columns.biome[i] = Biome(best);
+    }
+}
+
+void TerrainGenerator::placeBlocks(Chunk &chunk, const Columns &columns) const
+{
+    ChunkPos pos = chunk.position();
+
+    // One row of 16 columns at a time: the cave fields are sampled for every block from y = 1 to the highest
+    // surface in the row, 16 samples per layer so the kernels always see whole batches of 8
+    std::vector<float> xs, ys, zs, caveA, caveB;
+    for (int z = 0; z < CHUNK_SIZE; ++z)
+    {
+        const int *heights = columns.height + z * CHUNK_SIZE;
+        int rowMax = *std::max_element(heights, heights + CHUNK_SIZE);
+        int layers = rowMax; // y = 1 .. rowMax
+        int count = layers * CHUNK_SIZE;
+
+        xs.resize(count);
+        ys.resize(count);
+        zs.resize(count);
+        caveA.resize(count);
+        caveB.resize(count);
+        for (int layer = 0; layer < layers; ++layer)
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                int i = layer * CHUNK_SIZE + x;
+                xs[i] = float(pos.x * CHUNK_SIZE + x);
+                ys[i] = float(layer + 1) * CAVE_Y_STRETCH;
+                zs[i] = float(pos.z * CHUNK_SIZE + z);
+            }
+        m_caveA.fbm3(xs.data(), ys.data(), zs.data(), caveA.data(), count, CAVE_NOISE, m_level);
+        m_caveB.fbm3(xs.data(), ys.data(), zs.data(), caveB.data(), count, CAVE_NOISE, m_level);
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            int height = heights[x];
+            const BiomeProfile &profile = BIOMES[int(columns.biome[z * CHUNK_SIZE + x])];
+            BlockID top = profile.top;
+            if (columns.biome[z * CHUNK_SIZE + x] == Biome::MOUNTAINS && height > SNOW_LINE)
+                top = Blocks::ICE;
+
+            chunk.setBlock(x, 0, z, Blocks::STONE); // Caves never cut through the floor of the world
+            for (int y = 1; y <= height; ++y)
+            {
+                int i = (y - 1) * CHUNK_SIZE + x;
+                if (caveA[i] * caveA[i] + caveB[i] * caveB[i] < CAVE_RADIUS_SQ)
+                    continue;
+
+                BlockID id = Blocks::STONE;
+                if (y == height)
+                    id = top;
+                else if (y > height - 1 - FILLER_DEPTH)
+                    id = profile.filler;
+                else if (y < GOLD_MAX_Y &&
+                         hashBlock(m_seed, pos.x * CHUNK_SIZE + x, y, pos.z * CHUNK_SIZE + z) < GOLD_CHANCE)
+                    id = Blocks::GOLD_ORE;
+                chunk.setBlock(x, y, z, id);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef TERRAIN_GENERATOR_H
+#define TERRAIN_GENERATOR_H
+
+#include <cstdint> // For std::uint64_t seeds
+#include <memory>  // For std::unique_ptr
+
+#include "world/chunk.h"
+#include "world/noise.h"
+
+enum class Biome : std::uint8_t
+{
+    DESERT = 0,
+    PLAINS,
+    HILLS,
+    MOUNTAINS,
+    COUNT
+};
+
+// Deterministic terrain: the same seed and chunk position always give the same blocks, on every SIMD level
+// and in any order, so chunks can be generated on any thread and regenerated instead of saved.
+//
+// Per chunk it evaluates three 2D fBm fields (continent shape, detail, biome) for the 256 columns, blends the
+// height profiles of neighbouring biomes, then carves spaghetti caves where two 3D noise fields are both near
+// zero. The noise runs in batches of 8 columns per call to the SIMD kernels.
+class TerrainGenerator
+{
+public:
+    explicit TerrainGenerator(std::uint64_t seed, SimdLevel level = detectSimdLevel());
+
+    // Fills a freshly constructed (all air) chunk
+    void generate(Chunk &chunk) const;
+    std::unique_ptr<Chunk> generate(ChunkPos pos) const;
+
+    std::uint64_t seed() const { return m_seed; }
+    SimdLevel simdLevel() const { return m_level; }
+
+private:
+    struct Columns
+    {
+        int height[CHUNK_SIZE * CHUNK_SIZE];  // Y of the surface block, index z * 16 + x
+        Biome biome[CHUNK_SIZE * CHUNK_SIZE]; // Biome with the largest blend weight
+    };
+
+    void generateColumns(ChunkPos pos, Columns &columns) const;
+    void placeBlocks(Chunk &chunk, const Columns &columns) const;
+
+    std::uint64_t m_seed;
+    SimdLevel m_level;
+    PerlinNoise m_continent;
+    PerlinNoise m_detail;
+    PerlinNoise m_biome;
+    PerlinNoise m_caveA;
+    PerlinNoise m_caveB;
+};
+
+#endif
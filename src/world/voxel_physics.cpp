@@ -0,0 +1,161 @@
+#include "world/voxel_physics.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::floor, std::ceil
+
+namespace
+{
+    // Boxes closer than this to a block face count as touching it, so rounding never lets them sink in
+    constexpr float CONTACT_EPSILON = 1e-4f;
+
+    float &axisOf(Vec3 &v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+    float axisOf(const Vec3 &v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+    // Solid block lookups; the last chunk is remembered since a sweep only touches a handful of blocks
+    class SolidReader
+    {
+    public:
+        explicit SolidReader(const World &world) : m_world(world) {}
+
+        bool solid(int x, int y, int z)
+        {
+            if (y < 0)
+                return true;
+            if (y >= CHUNK_HEIGHT)
+                return false;
+            ChunkPos pos = World::chunkPosFor(x, z);
+            if (!m_valid || pos != m_pos)
+            {
+                m_chunk = m_world.getChunk(pos);
+                m_pos = pos;
+                m_valid = true;
+            }
+            return !m_chunk || isSolid(m_chunk->getBlock(x & 15, y, z & 15));
+        }
+
+    private:
+        const World &m_world;
+        const Chunk *m_chunk = nullptr;
+        ChunkPos m_pos;
+        bool m_valid = false;
+    };
+
+    // Part of delta the box can move along one axis. Walks the layers of blocks between the face of the box
+    // and where that face would end up, nearest first; the first layer holding a solid block that overlaps
+    // the box on the other two axes stops it.
+    float sweepAxis(SolidReader &blocks, const Aabb &box, int axis, float delta)
+    {
+        if (delta == 0.0f)
+            return 0.0f;
+        int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        int uFirst = int(std::floor(axisOf(box.min, u) + CONTACT_EPSILON));
+        int uLast = int(std::floor(axisOf(box.max, u) - CONTACT_EPSILON));
+        int vFirst = int(std::floor(axisOf(box.min, v) + CONTACT_EPSILON));
+        int vLast = int(std::floor(axisOf(box.max, v) - CONTACT_EPSILON));
+
+        bool positive = delta > 0.0f;
+        float face = positive ? axisOf(box.max, axis) : axisOf(box.min, axis);
+        int first = positive ? int(std::ceil(face - CONTACT_EPSILON)) : int(std::floor(face + CONTACT_EPSILON)) - 1;
+        int last = positive ? int(std::ceil(face + delta)) - 1 : int(std::floor(face + delta));
+        int step = positive ? 1 : -1;
+
+        int cell[3];
+        for (int layer = first; positive ? layer <= last : layer >= last; layer += step)
+        {
+            cell[axis] = layer;
+            for (cell[u] = uFirst; cell[u] <= uLast; ++cell[u])
+                for (cell[v] = vFirst; cell[v] <= vLast; ++cell[v])
+                    if (blocks.solid(cell[0], cell[1], cell[2]))
+                        return positive ? std::max(0.0f, std::min(delta, float(layer) - face))
+                                        : std::min(0.0f, std::max(delta, float(layer + 1) - face));
+        }
+        return delta;
+    }
+
+    void moveBox(Aabb &box, int axis, float distance)
+    {
+        axisOf(box.min, axis) += distance;
+        axisOf(box.max, axis) += distance;
+    }
+
+    // Sweeps y, x, z in turn, moving the box along
+    Vec3 sweep(SolidReader &blocks, Aabb &box, Vec3 delta)
+    {
+        Vec3 moved;
+        for (int axis : {1, 0, 2})
+        {
+            axisOf(moved, axis) = sweepAxis(blocks, box, axis, axisOf(delta, axis));
+            moveBox(box, axis, axisOf(moved, axis));
+        }
+        return moved;
+    }
+}
+
+Vec3 sweepBox(const World &world, const Aabb &box, Vec3 delta)
+{
+    SolidReader blocks(world);
+    Aabb moving = box;
+    return sweep(blocks, moving, delta);
+}
+
+void stepBody(const World &world, PhysicsBody &body, float dt, const PhysicsSettings &settings)
+{
+    body.velocity.y = std::max(body.velocity.y - settings.gravity * dt, -settings.terminalVelocity);
+    Vec3 delta = body.velocity * dt;
+
+    SolidReader blocks(world);
+    Aabb box = bodyBox(body);
+    Aabb start = box;
+    Vec3 moved = sweep(blocks, box, delta);
+
+    bool landed = delta.y < 0.0f && moved.y > delta.y;
+    bool hitCeiling = delta.y > 0.0f && moved.y < delta.y;
+
+    // Blocked sideways while walking on the ground: try again from up to stepHeight higher, then settle back
+    // down, and keep that if it got further
+    bool blockedSideways = moved.x != delta.x || moved.z != delta.z;
+    if (blockedSideways && delta.y <= 0.0f && (body.onGround || landed) && settings.stepHeight > 0.0f)
+    {
+        Aabb stepped = start;
+        Vec3 steppedMoved;
+        float up = sweepAxis(blocks, stepped, 1, settings.stepHeight);
+        moveBox(stepped, 1, up);
+        steppedMoved.x = sweepAxis(blocks, stepped, 0, delta.x);
+        moveBox(stepped, 0, steppedMoved.x);
+        steppedMoved.z = sweepAxis(blocks, stepped, 2, delta.z);
+        moveBox(stepped, 2, steppedMoved.z);
+        float fall = delta.y - up;
+        float down = sweepAxis(blocks, stepped, 1, fall);
+        moveBox(stepped, 1, down);
+        steppedMoved.y = up + down;
+
+        if (steppedMoved.x * steppedMoved.x + steppedMoved.z * steppedMoved.z > moved.x * moved.x + moved.z * moved.z)
+        {
+            moved = steppedMoved;
+            box = stepped;
+            landed = down > fall;
+        }
+    }
+
+    body.onGround = landed;
+    if (moved.x != delta.x)
+        body.velocity.x = 0.0f;
+    if (landed || hitCeiling)
+        body.velocity.y = 0.0f;
+    if (moved.z != delta.z)
+        body.velocity.z = 0.0f;
+    body.position = {(box.min.x + box.max.x) * 0.5f, box.min.y, (box.min.z + box.max.z) * 0.5f};
+}
+
+void stepBodies(const World &world, std::vector<PhysicsBody> &bodies, float dt, const PhysicsSettings &settings, JobSystem *jobs)
+{
+    auto step = [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+            stepBody(world, bodies[i], dt, settings);
+    };
+    if (jobs)
+        jobs->parallelFor(0, bodies.size(), 256, step);
+    else
+        step(0, bodies.size());
+}
@@ -0,0 +1,52 @@
+#ifndef VOXEL_PHYSICS_H
+#define VOXEL_PHYSICS_H
+
+#include <vector> // For batches of bodies
+
+#include "core/frustum.h"
+#include "core/job_system.h"
+#include "world/world.h"
+
+// Collision of axis aligned boxes (players, entities) with the block grid. A move is swept one axis at a time,
+// vertical first: along each axis the box advances through the layers of blocks ahead of it until the first
+// layer with a solid block, and stops flush against it. Keeping the axes apart lets a box slide along walls
+// and floors without any contact solving. Blocks are read straight from the chunks and nothing is allocated.
+//
+// Blocks below the world and in unloaded chunks count as solid, so nothing falls out of the loaded area.
+// Bodies only read the world, so any number may be stepped on worker threads while nothing edits it.
+
+// A box standing on its position (the centre of its bottom face)
+struct PhysicsBody
+{
+    Vec3 position;
+    Vec3 velocity;         // Blocks per second
+    float halfWidth = 0.3f;
+    float height = 1.8f;
+    bool onGround = false; // Resting on a block after the last step
+};
+
+struct PhysicsSettings
+{
+    float gravity = 28.0f;          // Blocks per second squared
+    float terminalVelocity = 60.0f; // Fastest fall, blocks per second
+    float stepHeight = 1.0f;        // Ledges up to this high are walked up instead of blocking the way
+};
+
+inline Aabb bodyBox(const PhysicsBody &body)
+{
+    return {{body.position.x - body.halfWidth, body.position.y, body.position.z - body.halfWidth},
+            {body.position.x + body.halfWidth, body.position.y + body.height, body.position.z + body.halfWidth}};
+}
+
+// How far of delta the box can move before hitting solid blocks, swept along y, then x, then z
+Vec3 sweepBox(const World &world, const Aabb &box, Vec3 delta);
+
+// Applies gravity and moves the body by its velocity over dt: stepping up low ledges when it walks on the
+// ground, zeroing the velocity along every axis it was stopped on and updating onGround.
+void stepBody(const World &world, PhysicsBody &body, float dt, const PhysicsSettings &settings = {});
+
+// Steps every body, spread over the job system's workers when one is given
+void stepBodies(const World &world, std::vector<PhysicsBody> &bodies, float dt, const PhysicsSettings &settings = {},
+                JobSystem *jobs = nullptr);
+
+#endif
@@ -0,0 +1,133 @@
+#include "world/voxel_raycast.h"
+
+#include <cmath>  // For std::floor, std::abs
+#include <limits> // For std::numeric_limits
+
+namespace
+{
+    // Walks the blocks along the ray until stop(id) is true or maxDistance is passed
+    template <typename Stop>
+    RayHit traverse(const World &world, Vec3 origin, Vec3 direction, float maxDistance, Stop stop)
+    {
+        RayHit result;
+        float len = length(direction);
+        if (len == 0.0f)
+            return result;
+        Vec3 d = direction * (1.0f / len);
+
+        int x = int(std::floor(origin.x));
+        int y = int(std::floor(origin.y));
+        int z = int(std::floor(origin.z));
+        int stepX = d.x > 0.0f ? 1 : (d.x < 0.0f ? -1 : 0);
+        int stepY = d.y > 0.0f ? 1 : (d.y < 0.0f ? -1 : 0);
+        int stepZ = d.z > 0.0f ? 1 : (d.z < 0.0f ? -1 : 0);
+
+        // Distance along the ray between two crossings of the same axis, and to the next crossing of each axis
+        const float NEVER = std::numeric_limits<float>::infinity();
+        float deltaX = stepX ? std::abs(1.0f / d.x) : NEVER;
+        float deltaY = stepY ? std::abs(1.0f / d.y) : NEVER;
+        float deltaZ = stepZ ? std::abs(1.0f / d.z) : NEVER;
+        float nextX = stepX > 0 ? (float(x + 1) - origin.x) * deltaX : (stepX < 0 ? (origin.x - float(x)) * deltaX : NEVER);
+        float nextY = stepY > 0 ? (float(y + 1) - origin.y) * deltaY : (stepY < 0 ? (origin.y - float(y)) * deltaY : NEVER);
+        float nextZ = stepZ > 0 ? (float(z + 1) - origin.z) * deltaZ : (stepZ < 0 ? (origin.z - float(z)) * deltaZ : NEVER);
+
+        // A ray starting inside a block reports the face it would leave through backwards
+        float ax = std::abs(d.x), ay = std::abs(d.y), az = std::abs(d.z);
+        Face face = ax >= ay && ax >= az ? (stepX > 0 ? Face::NEG_X : Face::POS_X)
+                    : ay >= az           ? (stepY > 0 ? Face::NEG_Y : Face::POS_Y)
+                                         : (stepZ > 0 ? Face::NEG_Z : Face::POS_Z);
+        float t = 0.0f;
+
+        // The chunk is only looked up again when the ray crosses into another one
+        const Chunk *chunk = world.getChunk(World::chunkPosFor(x, z));
+        ChunkPos chunkPos = World::chunkPosFor(x, z);
+
+        for (;;)
+        {
+            ++result.steps;
+            if (y >= 0 && y < CHUNK_HEIGHT)
+            {
+                ChunkPos pos = World::chunkPosFor(x, z);
+                if (pos != chunkPos)
+                {
+                    chunk = world.getChunk(pos);
+                    chunkPos = pos;
+                }
+                if (chunk && chunk->section(y / SECTION_SIZE))
+                {
+                    BlockID id = chunk->getBlock(x & 15, y, z & 15);
+                    if (stop(id))
+                    {
+                        result.hit = true;
+                        result.block = {x, y, z};
+                        result.face = face;
+                        result.id = id;
+                        result.distance = t;
+                        return result;
+                    }
+                }
+            }
+            else if ((y < 0 && stepY <= 0) || (y >= CHUNK_HEIGHT && stepY >= 0))
+                return result; // Left the world and never coming back
+
+            if (nextX < nextY && nextX < nextZ)
+            {
+                t = nextX;
+                nextX += deltaX;
+                x += stepX;
+                face = stepX > 0 ? Face::NEG_X : Face::POS_X;
+            }
+            else if (nextY < nextZ)
+            {
+                t = nextY;
+                nextY += deltaY;
+                y += stepY;
+                face = stepY > 0 ? Face::NEG_Y : Face::POS_Y;
+            }
+            else
+            {
+                t = nextZ;
+                nextZ += deltaZ;
+                z += stepZ;
+                face = stepZ > 0 ? Face::NEG_Z : Face::POS_Z;
+            }
+            if (t > maxDistance)
+                return result;
+        }
+    }
+}
+
+IVec3 RayHit::adjacent() const
+{
+    static const IVec3 NORMALS[6] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    const IVec3 &n = NORMALS[int(face)];
+    return {block.x + n.x, block.y + n.y, block.z + n.z};
+}
+
+RayHit raycast(const World &world, Vec3 origin, Vec3 direction, float maxDistance)
+{
+    return traverse(world, origin, direction, maxDistance, [](BlockID id) { return id != Blocks::AIR; });
+}
+
+bool lineOfSight(const World &world, Vec3 from, Vec3 to)
+{
+    RayHit hit = traverse(world, from, to - from, length(to - from), [](BlockID id) { return isOpaque(id); });
+    if (!hit.hit)
+        return true;
+    IVec3 target{int(std::floor(to.x)), int(std::floor(to.y)), int(std::floor(to.z))};
+    return hit.block == target;
+}
+
+void lineOfSight(const World &world, const std::vector<SightQuery> &queries, std::vector<std::uint8_t> &visible, JobSystem *jobs)
+{
+    visible.resize(queries.size());
+    auto answer = [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+            visible[i] = lineOfSight(world, queries[i].from, queries[i].to);
+    };
+    if (jobs)
+        jobs->parallelFor(0, queries.size(), 256, answer);
+    else
+        answer(0, queries.size());
+}
@@ -0,0 +1,47 @@
+#ifndef VOXEL_RAYCAST_H
+#define VOXEL_RAYCAST_H
+
+#include <cstdint> // For std::uint8_t results
+#include <vector>  // For batched queries
+
+#include "core/job_system.h"
+#include "core/vecmath.h"
+#include "world/world.h"
+
+// Rays through the block grid with the Amanatides-Woo DDA: from the block holding the origin, the ray steps
+// into whichever neighbour its next boundary crossing leads to, so every block it passes is visited exactly
+// once and in order, with no fixed step size to miss corners. Blocks are read straight from the chunks, and
+// sections without blocks are passed without reading anything.
+//
+// Rays only read the world, so any number may run on worker threads while nothing edits it.
+
+struct RayHit
+{
+    bool hit = false;
+    IVec3 block;             // The block that was hit
+    Face face = Face::POS_Y; // Face it was entered through, facing the origin
+    BlockID id = Blocks::AIR;
+    float distance = 0.0f;   // Along the ray to the entry point; 0 if the ray starts inside the block
+    int steps = 0;           // Blocks visited, the hit included
+
+    // Where a block placed against the hit face goes
+    IVec3 adjacent() const;
+};
+
+// First non-air block along the ray within maxDistance. direction need not be normalised.
+RayHit raycast(const World &world, Vec3 origin, Vec3 direction, float maxDistance);
+
+// True if no opaque block lies between from and to (the block containing to does not count)
+bool lineOfSight(const World &world, Vec3 from, Vec3 to);
+
+struct SightQuery
+{
+    Vec3 from;
+    Vec3 to;
+};
+
+// Answers a batch of line of sight queries (AI agents checking their targets), spread over the job system's
+// workers when one is given. visible[i] is 1 if queries[i] is unobstructed.
+void lineOfSight(const World &world, const std::vector<SightQuery> &queries, std::vector<std::uint8_t> &visible, JobSystem *jobs = nullptr);
+
+#endif
@@ -0,0 +1,98 @@
+#include "world/world.h"
+
+static_assert(CHUNK_SIZE == 16, "World::floorDivChunk and the & 15 masks assume 16-wide chunks");
+
+Chunk *World::getChunk(ChunkPos pos)
+{
+    auto it = m_chunks.find(pos);
+    return it != m_chunks.end() ? it->second.get() : nullptr;
+}
+
+const Chunk *World::getChunk(ChunkPos pos) const
+{
+    auto it = m_chunks.find(pos);
+    return it != m_chunks.end() ? it->second.get() : nullptr;
+}
+
+Chunk &World::getOrCreateChunk(ChunkPos pos)
+{
+    std::unique_ptr<Chunk> &slot = m_chunks[pos];
+    if (!slot)
+        slot = std::make_unique<Chunk>(pos);
+    return *slot;
+}
+
+Chunk &World::insertChunk(std::unique_ptr<Chunk> chunk)
+{
+    ChunkPos pos = chunk->position();
+    std::unique_ptr<Chunk> &slot = m_chunks[pos];
+    slot = std::move(chunk);
+    slot->markAllDirty();
+
+    // Diagonal neighbours too: their corner ambient occlusion samples blocks in this chunk
+    for (int dz = -1; dz <= 1; ++dz)
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            if (dx == 0 && dz == 0)
+                continue;
+            if (Chunk *neighbour = getChunk({pos.x + dx, pos.z + dz}))
+                for (int sectionY = 0; sectionY < SECTIONS_PER_CHUNK; ++sectionY)
+                    if (neighbour->section(sectionY))
+                        neighbour->markSectionDirty(sectionY);
+        }
+    return *slot;
+}
+
+bool World::removeChunk(ChunkPos pos)
+{
+    return m_chunks.erase(pos) > 0;
+}
+
+BlockID World::getBlock(int x, int y, int z) const
+{
+    const Chunk *chunk = getChunk(chunkPosFor(x, z));
+    return chunk ? chunk->getBlock(x & 15, y, z & 15) : BlockID(Blocks::AIR);
+}
+
+void World::setBlock(int x, int y, int z, BlockID id)
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return;
+    int localX = x & 15;
+    int localZ = z & 15;
+    ChunkPos pos = chunkPosFor(x, z);
+    Chunk *chunk = getChunk(pos);
+    if (!chunk || chunk->getBlock(localX, y, localZ) == id)
+        return;
+    chunk->setBlock(localX, y, localZ, id);
+
+    // Blocks on a chunk edge change the faces of the neighbouring chunks too: the faces touching them and,
+    // through ambient occlusion, the faces whose corners they shade. The mesher reads a one block border from
+    // all eight neighbours, so an edge or corner block reaches the sections of those it borders, including
+    // the ones above or below on a section boundary.
+    int sectionY = y / SECTION_SIZE;
+    int localY = y % SECTION_SIZE;
+    int firstDy = localY == 0 && sectionY > 0 ? -1 : 0;
+    int lastDy = localY == SECTION_SIZE - 1 && sectionY < SECTIONS_PER_CHUNK - 1 ? 1 : 0;
+    int firstDx = localX == 0 ? -1 : 0;
+    int lastDx = localX == CHUNK_SIZE - 1 ? 1 : 0;
+    int firstDz = localZ == 0 ? -1 : 0;
+    int lastDz = localZ == CHUNK_SIZE - 1 ? 1 : 0;
+    for (int dz = firstDz; dz <= lastDz; ++dz)
+        for (int dx = firstDx; dx <= lastDx; ++dx)
+        {
+            if (dx == 0 && dz == 0)
+                continue; // Chunk::setBlock marked its own sections
+            if (Chunk *n = getChunk({pos.x + dx, pos.z + dz}))
+                for (int dy = firstDy; dy <= lastDy; ++dy)
+                    n->markSectionDirty(sectionY + dy);
+        }
+}
+
+std::size_t World::memoryUsage() const
+{
+    std::size_t bytes = sizeof(*this);
+    for (const auto &[pos, chunk] : m_chunks)
+        bytes += sizeof(pos) + sizeof(chunk) + chunk->memoryUsage();
+    return bytes;
+}
@@ -0,0 +1,45 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <cstddef>       // For std::size_t
+#include <memory>        // For std::unique_ptr
+#include <unordered_map> // For the chunk hash map
+
+#include "world/chunk.h"
+
+// The world is a sparse set of chunks keyed by chunk coordinates.
+// Block coordinates are global; negative coordinates are fine.
+class World
+{
+public:
+    using ChunkMap = std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash>;
+
+    // Returns nullptr if the chunk is not loaded
+    Chunk *getChunk(ChunkPos pos);
+    const Chunk *getChunk(ChunkPos pos) const;
+
+    Chunk &getOrCreateChunk(ChunkPos pos);
+
+    // Adds a chunk built elsewhere (e.g. generated on a worker thread), replacing any chunk at its position.
+    // Neighbours are marked dirty since their border faces may now be hidden.
+    Chunk &insertChunk(std::unique_ptr<Chunk> chunk);
+    bool removeChunk(ChunkPos pos);
+
+    // Blocks in unloaded chunks read as air; writes to unloaded chunks are dropped, since a chunk created here
+    // would later be replaced wholesale by the generated or loaded one
+    BlockID getBlock(int x, int y, int z) const;
+    void setBlock(int x, int y, int z, BlockID id);
+
+    static ChunkPos chunkPosFor(int x, int z) { return {floorDivChunk(x), floorDivChunk(z)}; }
+
+    const ChunkMap &chunks() const { return m_chunks; }
+    std::size_t chunkCount() const { return m_chunks.size(); }
+    std::size_t memoryUsage() const;
+
+private:
+    static int floorDivChunk(int v) { return v >> 4; } // CHUNK_SIZE is 16, arithmetic shift floors negatives
+
+    ChunkMap m_chunks;
+};
+
+#endif
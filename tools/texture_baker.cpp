@@ -0,0 +1,62 @@
+// Build-time texture conversion: cuts the block textures out of the sheet, resamples them to array layers,
+// builds their mip chains and writes a baked container (texture/baked_texture.h) the game maps at startup.
+// CMake runs it through the bake_textures target whenever the images or the baker change.
+//
+// Usage: texture_baker <imageDirectory> <output> [rgba8|bc1|bc3] [layerSize]   (default bc1 and 256)
+
+#include <cstdio>  // For std::printf
+#include <cstdlib> // For std::atoi
+#include <string>  // For arguments
+
+#include "core/job_system.h"
+#include "texture/baked_texture.h"
+#include "texture/texture_atlas.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::printf("Usage: %s <imageDirectory> <output> [rgba8|bc1|bc3] [layerSize]\n", argv[0]);
+        return 1;
+    }
+    std::string imageDirectory = argv[1];
+    std::string output = argv[2];
+    BakedFormat format = BakedFormat::BC1;
+    if (argc > 3 && !parseBakedFormat(argv[3], format))
+    {
+        std::printf("Unknown format %s (expected rgba8, bc1 or bc3)\n", argv[3]);
+        return 1;
+    }
+    int layerSize = argc > 4 ? std::atoi(argv[4]) : 256;
+    if (layerSize <= 0 || (layerSize & (layerSize - 1)) != 0)
+    {
+        std::printf("The layer size must be a power of two, got %d\n", layerSize);
+        return 1;
+    }
+
+    JobSystem jobs;
+    AtlasOptions options;
+    options.padding = 0; // Only used to cut the layers from
+    options.jobs = &jobs;
+    TextureLayers layers = layersFromAtlas(loadOrBuildAtlas(blockTileSources(imageDirectory), options), layerSize, &jobs);
+    if (layers.empty())
+    {
+        std::printf("Failed to load the block textures from %s\n", imageDirectory.c_str());
+        return 1;
+    }
+
+    if (!writeBakedTexture(output, layers, format))
+    {
+        std::printf("Failed to write %s\n", output.c_str());
+        return 1;
+    }
+    BakedTexture baked;
+    if (!baked.open(output))
+    {
+        std::printf("Wrote %s but it does not read back\n", output.c_str());
+        return 1;
+    }
+    std::printf("Baked %d layers of %dx%d (%d mip levels, %s) into %s, %zu KiB\n", baked.layerCount(), baked.size(), baked.size(),
+                baked.mipCount(), bakedFormatName(baked.format()), output.c_str(), baked.fileSize() / 1024);
+    return 0;
+}